@@ -0,0 +1,76 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi, <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "Arena.hpp"
+
+namespace oatpp { namespace swagger {
+
+Arena::Arena(v_buff_size chunkSize)
+  : m_chunkSize(chunkSize > 0 ? chunkSize : 64 * 1024)
+  , m_position(nullptr)
+  , m_available(0)
+  , m_usedSize(0)
+{}
+
+Arena::~Arena() {
+  for(auto chunk : m_chunks) {
+    delete [] chunk;
+  }
+}
+
+void Arena::allocateChunk(v_buff_size minSize) {
+  v_buff_size size = minSize > m_chunkSize ? minSize : m_chunkSize;
+  m_position = new v_char8[size];
+  m_available = size;
+  m_chunks.push_back(m_position);
+}
+
+void* Arena::allocate(v_buff_size size, v_buff_size alignment) {
+
+  v_buff_size padding = (alignment - reinterpret_cast<v_buff_usize>(m_position) % alignment) % alignment;
+
+  if(m_position == nullptr || padding + size > m_available) {
+    allocateChunk(size + alignment);
+    padding = (alignment - reinterpret_cast<v_buff_usize>(m_position) % alignment) % alignment;
+  }
+
+  void* result = m_position + padding;
+  m_position += padding + size;
+  m_available -= padding + size;
+  m_usedSize += size;
+
+  return result;
+
+}
+
+v_buff_size Arena::getChunksCount() const {
+  return static_cast<v_buff_size>(m_chunks.size());
+}
+
+v_buff_size Arena::getUsedSize() const {
+  return m_usedSize;
+}
+
+}}
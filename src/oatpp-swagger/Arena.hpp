@@ -0,0 +1,138 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi, <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef oatpp_swagger_Arena_hpp
+#define oatpp_swagger_Arena_hpp
+
+#include "oatpp/Environment.hpp"
+
+#include <memory>
+#include <vector>
+
+namespace oatpp { namespace swagger {
+
+/**
+ * Monotonic memory arena. <br>
+ * Memory is handed out sequentially from big chunks and is never returned to the arena.
+ * All chunks are freed at once when the arena is destroyed. <br>
+ * *Arena is not thread-safe. It is meant to be filled by a single &id:oatpp::swagger::Generator; run.*
+ */
+class Arena {
+private:
+  v_buff_size m_chunkSize;
+  std::vector<p_char8> m_chunks;
+  p_char8 m_position;
+  v_buff_size m_available;
+  v_buff_size m_usedSize;
+private:
+  void allocateChunk(v_buff_size minSize);
+public:
+
+  /**
+   * Constructor.
+   * @param chunkSize - size of a single memory chunk.
+   */
+  Arena(v_buff_size chunkSize = 64 * 1024);
+
+  /**
+   * Non-copyable.
+   */
+  Arena(const Arena&) = delete;
+  Arena& operator=(const Arena&) = delete;
+
+  /**
+   * Destructor. Frees all chunks.
+   */
+  ~Arena();
+
+  /**
+   * Allocate memory.
+   * @param size - size of memory block.
+   * @param alignment - alignment of memory block.
+   * @return - pointer to allocated memory.
+   */
+  void* allocate(v_buff_size size, v_buff_size alignment);
+
+  /**
+   * Get number of chunks allocated by the arena.
+   * @return
+   */
+  v_buff_size getChunksCount() const;
+
+  /**
+   * Get total number of bytes handed out by the arena.
+   * @return
+   */
+  v_buff_size getUsedSize() const;
+
+};
+
+/**
+ * Standard-library compatible allocator backed by &l:Arena;. <br>
+ * Each allocator copy holds a reference to the arena, so the arena lives as long as any object allocated with it.
+ * @tparam T - allocated type.
+ */
+template<class T>
+class ArenaAllocator {
+  template<class U>
+  friend class ArenaAllocator;
+private:
+  std::shared_ptr<Arena> m_arena;
+public:
+  typedef T value_type;
+public:
+
+  ArenaAllocator(const std::shared_ptr<Arena>& arena)
+    : m_arena(arena)
+  {}
+
+  template<class U>
+  ArenaAllocator(const ArenaAllocator<U>& other)
+    : m_arena(other.m_arena)
+  {}
+
+  T* allocate(std::size_t n) {
+    return static_cast<T*>(m_arena->allocate(static_cast<v_buff_size>(n * sizeof(T)), alignof(T)));
+  }
+
+  void deallocate(T* /* ptr */, std::size_t /* n */) noexcept {
+    // Memory is released together with the arena.
+  }
+
+  template<class U>
+  bool operator==(const ArenaAllocator<U>& other) const {
+    return m_arena == other.m_arena;
+  }
+
+  template<class U>
+  bool operator!=(const ArenaAllocator<U>& other) const {
+    return m_arena != other.m_arena;
+  }
+
+};
+
+}}
+
+#endif /* oatpp_swagger_Arena_hpp */
@@ -25,18 +25,29 @@
 #ifndef oatpp_swagger_AsyncController_hpp
 #define oatpp_swagger_AsyncController_hpp
 
+#include "oatpp-swagger/ControllerConfig.hpp"
 #include "oatpp-swagger/ControllerPaths.hpp"
 #include "oatpp-swagger/Resources.hpp"
 #include "oatpp-swagger/Generator.hpp"
+#include "oatpp-swagger/DocumentEvents.hpp"
+#include "oatpp-swagger/DocumentHistory.hpp"
+#include "oatpp-swagger/DocumentState.hpp"
+#include "oatpp-swagger/Metrics.hpp"
+#include "oatpp-swagger/ResponseFactory.hpp"
 
 #include "oatpp/web/protocol/http/outgoing/StreamingBody.hpp"
 #include "oatpp/web/server/api/ApiController.hpp"
 
 #include "oatpp/json/ObjectMapper.hpp"
+#include "oatpp/encoding/Url.hpp"
+#include "oatpp/utils/Conversion.hpp"
 
 #include "oatpp/macro/codegen.hpp"
 #include "oatpp/macro/component.hpp"
 
+#include <atomic>
+#include <mutex>
+
 namespace oatpp { namespace swagger {
 
 /**
@@ -46,28 +57,72 @@ namespace oatpp { namespace swagger {
  * Exposed endpoints:
  * <ul>
  *   <li>&id:ENDPOINT_ASYNC;("GET", "/api-docs/oas-3.0.0.json", Api) - Server Open API Specification.</li>
+ *   <li>&id:ENDPOINT_ASYNC;("GET", "/api-docs/oas-3.0.0/tags/{tag}", ApiTag) - Serve per-tag sub-document of the Open Api Specification.
+ *   See &id:oatpp::swagger::TagDocuments;.</li>
+ *   <li>&id:ENDPOINT_ASYNC;("GET", "/api-docs/oas-3.0.0/{version}.json", ApiVersion) - Serve content-addressed Open Api Specification
+ *   with `Cache-Control: immutable`. See &id:oatpp::swagger::ControllerConfig::contentAddressedSpec;.</li>
+ *   <li>&id:ENDPOINT_ASYNC;("GET", "/api-docs/index.json", ApiIndex) - Serve compact index of all operations.
+ *   See &id:oatpp::swagger::OperationIndex;.</li>
+ *   <li>&id:ENDPOINT_ASYNC;("GET", "/api-docs/search?q={query}", Search) - Search operations and schemas.
+ *   See &id:oatpp::swagger::SearchIndex;.</li>
+ *   <li>&id:ENDPOINT_ASYNC;("GET", "/api-docs/fragment?ptr={pointer}", Fragment) - Serve sub-tree of the Open Api Specification.
+ *   See &id:oatpp::swagger::DocumentFragments;.</li>
+ *   <li>&id:ENDPOINT_ASYNC;("GET", "/api-docs/delta?from={version}", Delta) - Serve JSON Patch from the previous version of the document.
+ *   See &id:oatpp::swagger::DocumentHistory;.</li>
+ *   <li>&id:ENDPOINT_ASYNC;("GET", "/api-docs/events", Events) - Server-Sent Events about the published documents.
+ *   See &id:oatpp::swagger::DocumentEvents; and &id:oatpp::swagger::ControllerConfig::events;.</li>
  *   <li>&id:ENDPOINT_ASYNC;("GET", "/swagger/ui", GetUIRoot) - Server Swagger-UI. (index.html).</li>
  *   <li>&id:ENDPOINT_ASYNC;("GET", "/swagger/{filename}", GetUIResource) - Serve Swagger-UI resources.</li>
+ *   <li>&id:ENDPOINT_ASYNC;("HEAD", ...) - `HEAD` variants of the endpoints above (HeadApi, HeadUIRoot, HeadInitializer, HeadUIResource).
+ *   Answered from the precomputed length and ETag, without reading files or serializing the document. Not counted in &id:oatpp::swagger::Metrics;.</li>
+ *   <li>&id:ENDPOINT_ASYNC;("GET", "/api-docs/metrics", GetMetrics) - Serve &id:oatpp::swagger::Metrics; in Prometheus text format.</li>
+ *   <li>&id:ENDPOINT_ASYNC;("GET", "/api-docs/debug/size", GetSizeReport) - Serve size report of the Open Api Specification.
+ *   See &id:oatpp::swagger::SizeAnalyzer;.</li>
  * </ul>
  */
 class AsyncController : public oatpp::web::server::api::ApiController {
 public:
   typedef AsyncController __ControllerType;
 private:
-  oatpp::Object<oas3::Document> m_document;
+  std::shared_ptr<ObjectMapper> m_objectMapper;
   std::shared_ptr<oatpp::swagger::Resources> m_resources;
 private:
   ControllerPaths m_paths;
+  ControllerConfig m_config;
+  std::shared_ptr<Generator::Stats> m_stats;
+  std::shared_ptr<Metrics> m_metrics;
+  std::shared_ptr<DocumentHistory> m_history;
+  std::shared_ptr<DocumentEvents> m_events;
+private:
+  std::mutex m_stateMutex;
+  std::shared_ptr<DocumentState> m_state;
 public:
   AsyncController(const std::shared_ptr<ObjectMapper>& objectMapper,
-             const oatpp::Object<oas3::Document>& document,
-             const std::shared_ptr<oatpp::swagger::Resources>& resources,
-             const ControllerPaths& paths)
+                  const oatpp::Object<oas3::Document>& document,
+                  const std::shared_ptr<oatpp::swagger::Resources>& resources,
+                  const ControllerPaths& paths,
+                  const std::shared_ptr<Generator::Stats>& stats = nullptr,
+                  const std::shared_ptr<Metrics>& metrics = nullptr,
+                  const ControllerConfig& config = ControllerConfig())
     : oatpp::web::server::api::ApiController(objectMapper)
-    , m_document(document)
+    , m_objectMapper(objectMapper)
     , m_resources(resources)
     , m_paths(paths)
-  {}
+    , m_config(config)
+    , m_stats(stats)
+    , m_metrics(metrics)
+    , m_history(std::make_shared<DocumentHistory>(objectMapper, config.documentHistorySize))
+    , m_events(std::make_shared<DocumentEvents>(m_history, config.eventsKeepAliveInterval))
+  {
+    setDocument(document, stats ? stats->totalMicros : 0);
+  }
+
+  /**
+   * Virtual destructor. Ends open event streams.
+   */
+  ~AsyncController() override {
+    m_events->close();
+  }
 public:
 
   /**
@@ -93,6 +148,18 @@ public:
       generatorConfig = std::make_shared<Generator::Config>();
     }
 
+    if(generatorConfig->compact) {
+      // Escaping of '/' and non-ASCII characters is optional in JSON.
+      objectMapper->serializerConfig().json.escapeFlags = 0;
+    }
+
+    std::shared_ptr<Metrics> metrics;
+    try {
+      metrics = OATPP_GET_COMPONENT(std::shared_ptr<Metrics>);
+    } catch (std::runtime_error&) {
+      // DO nothing.
+    }
+
     Generator generator(generatorConfig);
     auto document = generator.generateDocument(documentInfo, endpointsList);
 
@@ -103,8 +170,124 @@ public:
     } catch (std::runtime_error&) {
       // DO nothing.
     }
+
+    ControllerConfig config;
+    try {
+      auto cfg = OATPP_GET_COMPONENT(std::shared_ptr<ControllerConfig>);
+      if(cfg) config = *cfg;
+    } catch (std::runtime_error&) {
+      // DO nothing.
+    }
     
-    return std::make_shared<AsyncController>(objectMapper, document, resources, paths);
+    auto stats = std::make_shared<Generator::Stats>(generator.getStats());
+    auto controller = std::make_shared<AsyncController>(objectMapper, document, resources, paths, stats, metrics, config);
+
+    auto documentSize = static_cast<v_int64>(controller->getState()->getDocumentCache()->getData()->size());
+    stats->serializedSize = documentSize;
+    if(generatorConfig->logStats) {
+      Generator::logStats("oatpp::swagger::AsyncController", *stats);
+    }
+
+    return controller;
+  }
+
+  /**
+   * Get statistics of the document generation.
+   * @return - &id:oatpp::swagger::Generator::Stats;. `nullptr` if the controller was constructed without stats.
+   */
+  std::shared_ptr<Generator::Stats> getStats() const {
+    return m_stats;
+  }
+
+  /**
+   * Get runtime metrics.
+   * @return - &id:oatpp::swagger::Metrics;. `nullptr` if &id:oatpp::swagger::Metrics; component is not registered.
+   */
+  std::shared_ptr<Metrics> getMetrics() const {
+    return m_metrics;
+  }
+
+  /**
+   * Get state of the currently served document.
+   * @return - &id:oatpp::swagger::DocumentState;.
+   */
+  std::shared_ptr<DocumentState> getState() const {
+    return std::atomic_load(&m_state);
+  }
+
+  /**
+   * Get history of the published documents.
+   * @return - &id:oatpp::swagger::DocumentHistory;.
+   */
+  std::shared_ptr<DocumentHistory> getHistory() const {
+    return m_history;
+  }
+
+  /**
+   * Get events about the published documents. Call &id:oatpp::swagger::DocumentEvents::close (); to end open event streams.
+   * @return - &id:oatpp::swagger::DocumentEvents;.
+   */
+  std::shared_ptr<DocumentEvents> getEvents() const {
+    return m_events;
+  }
+
+  /**
+   * Publish new API document. Serialization, indexing and rendering of the UI pages happen in the calling thread,
+   * then the new state replaces the old one at once. Requests in flight finish with the previous document.
+   * @param document - &id:oatpp::swagger::oas3::Document;.
+   * @param generationMicros - time it took to generate the document, for &id:oatpp::swagger::Metrics;. `0` if unknown.
+   */
+  void setDocument(const oatpp::Object<oas3::Document>& document, v_int64 generationMicros = 0) {
+    auto state = std::make_shared<DocumentState>(m_objectMapper, document, *m_resources, m_paths, m_config);
+    std::lock_guard<std::mutex> lock(m_stateMutex);
+    m_history->push(state->getDocumentCache());
+    std::atomic_store(&m_state, state);
+    if(m_metrics) {
+      m_metrics->recordDocument(generationMicros, static_cast<v_int64>(state->getDocumentCache()->getData()->size()));
+    }
+    m_events->publish(state->getDocumentCache()->getVersion());
+  }
+
+  /**
+   * Record response in metrics (if enabled).
+   * @param endpoint - &id:oatpp::swagger::Metrics::Endpoint;.
+   * @param response - response to send.
+   * @return - the same response.
+   */
+  std::shared_ptr<OutgoingResponse> recordResponse(Metrics::Endpoint endpoint, const std::shared_ptr<OutgoingResponse>& response) const {
+    if(m_metrics) {
+      m_metrics->recordResponse(endpoint, response);
+    }
+    return response;
+  }
+
+  /**
+   * Record request to the resource file in metrics (if enabled). Call only for the file which is actually served.
+   * @param filename - name of the resource file.
+   * @param resource - served resource. Counted as a cache hit if it is held in memory.
+   */
+  void recordFileRequest(const oatpp::String& filename, const std::shared_ptr<data::resource::Resource>& resource) const {
+    if(m_metrics) {
+      m_metrics->recordFileRequest(filename, resource->getInMemoryData() != nullptr);
+    }
+  }
+
+  /**
+   * Parse value of the `limit` query parameter. Responds with `400` if the value is not an integer in range `[1, maxLimit]`.
+   * @param param - value of the parameter. May be `nullptr`.
+   * @param defaultLimit - limit if the parameter is not set.
+   * @param maxLimit - max allowed limit.
+   * @return - limit.
+   */
+  static v_int32 parseLimit(const oatpp::String& param, v_int32 defaultLimit, v_int32 maxLimit) {
+    if(!param) {
+      return defaultLimit;
+    }
+    bool success;
+    auto limit = oatpp::utils::Conversion::strToInt32(param, success);
+    OATPP_ASSERT_HTTP(success && limit >= 1 && limit <= maxLimit, Status::CODE_400,
+                      "Invalid query parameter 'limit'. Expected integer in range [1, " + std::to_string(maxLimit) + "]")
+    return limit;
   }
   
 #include OATPP_CODEGEN_BEGIN(ApiController)
@@ -114,30 +297,206 @@ public:
     ENDPOINT_ASYNC_INIT(Api)
     
     Action act() override {
-      return _return(controller->createDtoResponse(Status::CODE_200, controller->m_document));
+      auto state = controller->getState();
+      auto resp = state->getPrebuiltResponses().getEndpoint(controller->m_paths.apiJson, request);
+      if(!resp) {
+        resp = ResponseFactory::createDataResponse(request,
+                                                   state->getDocumentCache()->getData(),
+                                                   state->getDocumentCache()->getETag(),
+                                                   "application/json");
+      }
+      return _return(controller->recordResponse(Metrics::Endpoint::API, resp));
     }
     
   };
   
+  ENDPOINT_ASYNC("HEAD", m_paths.apiJson, HeadApi) {
+
+    ENDPOINT_ASYNC_INIT(HeadApi)
+
+    Action act() override {
+      auto state = controller->getState();
+      return _return(ResponseFactory::createHeadResponse(request,
+                                                         static_cast<v_int64>(state->getDocumentCache()->getData()->size()),
+                                                         state->getDocumentCache()->getETag(),
+                                                         "application/json"));
+    }
+
+  };
+  
   ENDPOINT_ASYNC("GET", m_paths.ui, GetUIRoot) {
     
     ENDPOINT_ASYNC_INIT(GetUIRoot)
     
     Action act() override {
-      auto ui = controller->m_resources->getResourceData("index.html");
-      return _return(controller->createResponse(Status::CODE_200, ui));
+      auto state = controller->getState();
+      auto resp = state->getPrebuiltResponses().getEndpoint(controller->m_paths.ui, request);
+      if(state->getUIRoot().data) {
+        // Rendered page - no file is served.
+        if(!resp) {
+          resp = ResponseFactory::createContentResponse(request, state->getUIRoot());
+        }
+        return _return(controller->recordResponse(Metrics::Endpoint::UI_ROOT, resp));
+      }
+      auto resource = controller->m_resources->getResource("index.html");
+      controller->recordFileRequest("index.html", resource);
+      if(!resp) {
+        auto info = controller->m_resources->getResourceInfo("index.html");
+        resp = ResponseFactory::createResourceResponse(request,
+                                                       resource,
+                                                       info.size,
+                                                       info.etag,
+                                                       controller->m_resources->getMimeType("index.html"));
+      }
+      return _return(controller->recordResponse(Metrics::Endpoint::UI_ROOT, resp));
     }
     
   };
 
+  ENDPOINT_ASYNC("GET", m_paths.apiTag, ApiTag) {
+
+    ENDPOINT_ASYNC_INIT(ApiTag)
+
+    Action act() override {
+      auto state = controller->getState();
+      auto document = state->getTagDocuments()->getDocument(oatpp::encoding::Url::decode(request->getPathVariable("tag")));
+      OATPP_ASSERT_HTTP(document, Status::CODE_404, "Tag not found")
+      auto resp = ResponseFactory::createDataResponse(request, document->getData(), document->getETag(), "application/json");
+      return _return(controller->recordResponse(Metrics::Endpoint::API_TAG, resp));
+    }
+
+  };
+
+  ENDPOINT_ASYNC("GET", m_paths.apiIndex, ApiIndex) {
+
+    ENDPOINT_ASYNC_INIT(ApiIndex)
+
+    Action act() override {
+      auto state = controller->getState();
+      auto resp = state->getPrebuiltResponses().getEndpoint(controller->m_paths.apiIndex, request);
+      if(!resp) {
+        auto index = state->getOperationIndex();
+        resp = ResponseFactory::createDataResponse(request, index->getData(), index->getETag(), "application/json");
+      }
+      return _return(controller->recordResponse(Metrics::Endpoint::API_INDEX, resp));
+    }
+
+  };
+
+  ENDPOINT_ASYNC("GET", m_paths.search, Search) {
+
+    ENDPOINT_ASYNC_INIT(Search)
+
+    Action act() override {
+      auto state = controller->getState();
+      auto query = request->getQueryParameter("q");
+      OATPP_ASSERT_HTTP(query, Status::CODE_400, "Missing query parameter 'q'")
+      OATPP_ASSERT_HTTP(static_cast<v_buff_size>(query->size()) <= SearchIndex::MAX_QUERY_SIZE, Status::CODE_400, "Query is too long")
+      auto limit = parseLimit(request->getQueryParameter("limit"), SearchIndex::DEFAULT_LIMIT, SearchIndex::MAX_LIMIT);
+      auto results = state->getSearchIndex()->search(oatpp::encoding::Url::decode(query), limit);
+      return _return(controller->recordResponse(Metrics::Endpoint::SEARCH, controller->createDtoResponse(Status::CODE_200, results)));
+    }
+
+  };
+
+  ENDPOINT_ASYNC("GET", m_paths.fragment, Fragment) {
+
+    ENDPOINT_ASYNC_INIT(Fragment)
+
+    Action act() override {
+      auto state = controller->getState();
+      auto pointer = request->getQueryParameter("ptr");
+      OATPP_ASSERT_HTTP(pointer, Status::CODE_400, "Missing query parameter 'ptr'")
+      auto content = state->getFragments()->getFragment(oatpp::encoding::Url::decode(pointer));
+      OATPP_ASSERT_HTTP(content.data, Status::CODE_404, "Fragment not found")
+      return _return(controller->recordResponse(Metrics::Endpoint::FRAGMENT, ResponseFactory::createContentResponse(request, content)));
+    }
+
+  };
+
+  ENDPOINT_ASYNC("GET", m_paths.apiVersion, ApiVersion) {
+
+    ENDPOINT_ASYNC_INIT(ApiVersion)
+
+    Action act() override {
+      auto content = controller->m_history->getVersionContent(request->getPathVariable("version"));
+      OATPP_ASSERT_HTTP(content.data, Status::CODE_404, "Unknown document version")
+      return _return(controller->recordResponse(Metrics::Endpoint::API_VERSION, ResponseFactory::createContentResponse(request, content)));
+    }
+
+  };
+
+  ENDPOINT_ASYNC("GET", m_paths.delta, Delta) {
+
+    ENDPOINT_ASYNC_INIT(Delta)
+
+    Action act() override {
+      auto from = request->getQueryParameter("from");
+      OATPP_ASSERT_HTTP(from, Status::CODE_400, "Missing query parameter 'from'")
+      auto content = controller->m_history->getPatch(from);
+      OATPP_ASSERT_HTTP(content.data, Status::CODE_404, "Unknown document version")
+      return _return(controller->recordResponse(Metrics::Endpoint::DELTA, ResponseFactory::createContentResponse(request, content)));
+    }
+
+  };
+
+  ENDPOINT_ASYNC("GET", m_paths.events, Events) {
+
+    ENDPOINT_ASYNC_INIT(Events)
+
+    Action act() override {
+      OATPP_ASSERT_HTTP(controller->m_config.events, Status::CODE_404, "Events are not enabled")
+      // Idle subscribers are suspended coroutines on the events wait list - they take no threads.
+      auto subscription = controller->m_events->subscribe(request->getQueryParameter("delta", "false") == "true", request->getHeader("Last-Event-ID"));
+      return _return(controller->recordResponse(Metrics::Endpoint::EVENTS, ResponseFactory::createEventStreamResponse(subscription)));
+    }
+
+  };
+
+  ENDPOINT_ASYNC("HEAD", m_paths.ui, HeadUIRoot) {
+
+    ENDPOINT_ASYNC_INIT(HeadUIRoot)
+
+    Action act() override {
+      auto state = controller->getState();
+      std::shared_ptr<OutgoingResponse> resp;
+      const auto& uiRoot = state->getUIRoot();
+      if(uiRoot.data) {
+        resp = ResponseFactory::createContentHeadResponse(request, uiRoot);
+      } else {
+        auto info = controller->m_resources->getResourceInfo("index.html");
+        resp = ResponseFactory::createHeadResponse(request,
+                                                   info.size,
+                                                   info.etag,
+                                                   controller->m_resources->getMimeType("index.html"));
+      }
+      return _return(resp);
+    }
+
+  };
+
   ENDPOINT_ASYNC("GET", m_paths.initializer, GetInitializer) {
 
-  ENDPOINT_ASYNC_INIT(GetInitializer)
+    ENDPOINT_ASYNC_INIT(GetInitializer)
+
+    Action act() override {
+      auto state = controller->getState();
+      auto resp = state->getPrebuiltResponses().getEndpoint(controller->m_paths.initializer, request);
+      if(!resp) {
+        resp = ResponseFactory::createContentResponse(request, state->getInitializer());
+      }
+      return _return(controller->recordResponse(Metrics::Endpoint::INITIALIZER, resp));
+    }
+
+  };
+
+  ENDPOINT_ASYNC("HEAD", m_paths.initializer, HeadInitializer) {
+
+    ENDPOINT_ASYNC_INIT(HeadInitializer)
 
     Action act() override {
-      std::string ui = controller->m_resources->getResourceData("swagger-initializer.js");
-      ui.replace(ui.find("%%API.JSON%%"), 12, controller->m_paths.apiJson);
-      return _return(controller->createResponse(Status::CODE_200, ui));
+      auto state = controller->getState();
+      return _return(ResponseFactory::createContentHeadResponse(request, state->getInitializer()));
     }
 
   };
@@ -147,19 +506,72 @@ public:
     ENDPOINT_ASYNC_INIT(GetUIResource)
     
     Action act() override {
+      auto state = controller->getState();
       auto filename = request->getPathVariable("filename");
       OATPP_ASSERT_HTTP(filename, Status::CODE_400, "filename should not be null")
 
-      auto body = std::make_shared<oatpp::web::protocol::http::outgoing::StreamingBody>(
-        controller->m_resources->getResource(filename)->openInputStream()
-      );
-      auto resp = OutgoingResponse::createShared(Status::CODE_200, body);
-      resp->putHeader("Content-Type", controller->m_resources->getMimeType(filename));
-      return _return(resp);
+      auto resource = controller->m_resources->findResource(filename);
+      OATPP_ASSERT_HTTP(resource, Status::CODE_404, "Resource not found")
+      controller->recordFileRequest(filename, resource);
+      auto resp = state->getPrebuiltResponses().getResource(filename, request);
+      if(!resp) {
+        auto info = controller->m_resources->getResourceInfo(filename);
+        resp = ResponseFactory::createResourceResponse(request,
+                                                       resource,
+                                                       info.size,
+                                                       info.etag,
+                                                       controller->m_resources->getMimeType(filename));
+      }
+      return _return(controller->recordResponse(Metrics::Endpoint::UI_RESOURCE, resp));
 
     }
     
   };
+
+  ENDPOINT_ASYNC("HEAD", m_paths.uiResources, HeadUIResource) {
+
+    ENDPOINT_ASYNC_INIT(HeadUIResource)
+
+    Action act() override {
+      auto filename = request->getPathVariable("filename");
+      OATPP_ASSERT_HTTP(filename, Status::CODE_400, "filename should not be null")
+
+      OATPP_ASSERT_HTTP(controller->m_resources->findResource(filename), Status::CODE_404, "Resource not found")
+      auto info = controller->m_resources->getResourceInfo(filename);
+      return _return(ResponseFactory::createHeadResponse(request,
+                                                         info.size,
+                                                         info.etag,
+                                                         controller->m_resources->getMimeType(filename)));
+    }
+
+  };
+
+  ENDPOINT_ASYNC("GET", m_paths.metrics, GetMetrics) {
+
+    ENDPOINT_ASYNC_INIT(GetMetrics)
+
+    Action act() override {
+      OATPP_ASSERT_HTTP(controller->m_metrics, Status::CODE_404, "Metrics are not enabled")
+      auto resp = controller->createResponse(Status::CODE_200, controller->m_metrics->toPrometheusText());
+      resp->putHeader("Content-Type", "text/plain; version=0.0.4");
+      return _return(controller->recordResponse(Metrics::Endpoint::METRICS, resp));
+    }
+
+  };
+
+  ENDPOINT_ASYNC("GET", m_paths.sizeReport, GetSizeReport) {
+
+    ENDPOINT_ASYNC_INIT(GetSizeReport)
+
+    Action act() override {
+      OATPP_ASSERT_HTTP(controller->m_config.sizeReport, Status::CODE_404, "Size report is not enabled")
+      auto state = controller->getState();
+      auto limit = parseLimit(request->getQueryParameter("limit"), SizeAnalyzer::DEFAULT_LIMIT, SizeAnalyzer::MAX_LIMIT);
+      auto report = state->getSizeAnalyzer()->getReport(limit);
+      return _return(controller->recordResponse(Metrics::Endpoint::SIZE_REPORT, controller->createDtoResponse(Status::CODE_200, report)));
+    }
+
+  };
   
 #include OATPP_CODEGEN_END(ApiController)
   
@@ -25,18 +25,28 @@
 #ifndef oatpp_swagger_Controller_hpp
 #define oatpp_swagger_Controller_hpp
 
+#include "oatpp-swagger/ControllerConfig.hpp"
 #include "oatpp-swagger/ControllerPaths.hpp"
 #include "oatpp-swagger/Resources.hpp"
 #include "oatpp-swagger/Generator.hpp"
+#include "oatpp-swagger/DocumentHistory.hpp"
+#include "oatpp-swagger/DocumentState.hpp"
+#include "oatpp-swagger/Metrics.hpp"
+#include "oatpp-swagger/ResponseFactory.hpp"
 
 #include "oatpp/web/server/api/ApiController.hpp"
 
 #include "oatpp/json/ObjectMapper.hpp"
+#include "oatpp/encoding/Url.hpp"
+#include "oatpp/utils/Conversion.hpp"
 
 #include "oatpp/web/protocol/http/outgoing/StreamingBody.hpp"
 #include "oatpp/macro/codegen.hpp"
 #include "oatpp/macro/component.hpp"
 
+#include <atomic>
+#include <mutex>
+
 namespace oatpp { namespace swagger {
 
 /**
@@ -46,26 +56,59 @@ namespace oatpp { namespace swagger {
  * Exposed endpoints:
  * <ul>
  *   <li>&id:ENDPOINT;("GET", "/api-docs/oas-3.0.0.json", api) - Server Open API Specification.</li>
+ *   <li>&id:ENDPOINT;("GET", "/api-docs/oas-3.0.0/tags/{tag}", apiTag) - Serve per-tag sub-document of the Open Api Specification.
+ *   See &id:oatpp::swagger::TagDocuments;.</li>
+ *   <li>&id:ENDPOINT;("GET", "/api-docs/oas-3.0.0/{version}.json", apiVersion) - Serve content-addressed Open Api Specification
+ *   with `Cache-Control: immutable`. See &id:oatpp::swagger::ControllerConfig::contentAddressedSpec;.</li>
+ *   <li>&id:ENDPOINT;("GET", "/api-docs/index.json", apiIndex) - Serve compact index of all operations.
+ *   See &id:oatpp::swagger::OperationIndex;.</li>
+ *   <li>&id:ENDPOINT;("GET", "/api-docs/search?q={query}", search) - Search operations and schemas.
+ *   See &id:oatpp::swagger::SearchIndex;.</li>
+ *   <li>&id:ENDPOINT;("GET", "/api-docs/fragment?ptr={pointer}", fragment) - Serve sub-tree of the Open Api Specification.
+ *   See &id:oatpp::swagger::DocumentFragments;.</li>
+ *   <li>&id:ENDPOINT;("GET", "/api-docs/delta?from={version}", delta) - Serve JSON Patch from the previous version of the document.
+ *   See &id:oatpp::swagger::DocumentHistory;.</li>
  *   <li>&id:ENDPOINT;("GET", "/swagger/ui", getUIRoot) - Server Swagger-UI. (index.html).</li>
  *   <li>&id:ENDPOINT;("GET", "/swagger/{filename}", getUIResource) - Serve Swagger-UI resources.</li>
+ *   <li>&id:ENDPOINT;("HEAD", ...) - `HEAD` variants of the endpoints above (headApi, headUIRoot, headInitializer, headUIResource).
+ *   Answered from the precomputed length and ETag, without reading files or serializing the document. Not counted in &id:oatpp::swagger::Metrics;.</li>
+ *   <li>&id:ENDPOINT;("GET", "/api-docs/metrics", metrics) - Serve &id:oatpp::swagger::Metrics; in Prometheus text format.</li>
+ *   <li>&id:ENDPOINT;("GET", "/api-docs/debug/size", sizeReport) - Serve size report of the Open Api Specification.
+ *   See &id:oatpp::swagger::SizeAnalyzer;.</li>
  * </ul>
  */
 class Controller : public oatpp::web::server::api::ApiController {
 private:
-  oatpp::Object<oas3::Document> m_document;
+  std::shared_ptr<ObjectMapper> m_objectMapper;
   std::shared_ptr<oatpp::swagger::Resources> m_resources;
 private:
   ControllerPaths m_paths;
+  ControllerConfig m_config;
+  std::shared_ptr<Generator::Stats> m_stats;
+  std::shared_ptr<Metrics> m_metrics;
+  std::shared_ptr<DocumentHistory> m_history;
+private:
+  std::mutex m_stateMutex;
+  std::shared_ptr<DocumentState> m_state;
 public:
   Controller(const std::shared_ptr<ObjectMapper>& objectMapper,
              const oatpp::Object<oas3::Document>& document,
              const std::shared_ptr<oatpp::swagger::Resources>& resources,
-             const ControllerPaths& paths)
+             const ControllerPaths& paths,
+             const std::shared_ptr<Generator::Stats>& stats = nullptr,
+             const std::shared_ptr<Metrics>& metrics = nullptr,
+             const ControllerConfig& config = ControllerConfig())
     : oatpp::web::server::api::ApiController(objectMapper)
-    , m_document(document)
+    , m_objectMapper(objectMapper)
     , m_resources(resources)
     , m_paths(paths)
-  {}
+    , m_config(config)
+    , m_stats(stats)
+    , m_metrics(metrics)
+    , m_history(std::make_shared<DocumentHistory>(objectMapper, config.documentHistorySize))
+  {
+    setDocument(document, stats ? stats->totalMicros : 0);
+  }
 public:
 
   /**
@@ -91,6 +134,18 @@ public:
       generatorConfig = std::make_shared<Generator::Config>();
     }
 
+    if(generatorConfig->compact) {
+      // Escaping of '/' and non-ASCII characters is optional in JSON.
+      objectMapper->serializerConfig().json.escapeFlags = 0;
+    }
+
+    std::shared_ptr<Metrics> metrics;
+    try {
+      metrics = OATPP_GET_COMPONENT(std::shared_ptr<Metrics>);
+    } catch (std::runtime_error&) {
+      // DO nothing.
+    }
+
     Generator generator(generatorConfig);
     auto document = generator.generateDocument(documentInfo, endpointsList);
 
@@ -102,33 +157,346 @@ public:
       // DO nothing.
     }
 
-    return std::make_shared<Controller>(objectMapper, document, resources, paths);
+    ControllerConfig config;
+    try {
+      auto cfg = OATPP_GET_COMPONENT(std::shared_ptr<ControllerConfig>);
+      if(cfg) config = *cfg;
+    } catch (std::runtime_error&) {
+      // DO nothing.
+    }
+
+    auto stats = std::make_shared<Generator::Stats>(generator.getStats());
+    auto controller = std::make_shared<Controller>(objectMapper, document, resources, paths, stats, metrics, config);
+
+    auto documentSize = static_cast<v_int64>(controller->getState()->getDocumentCache()->getData()->size());
+    stats->serializedSize = documentSize;
+    if(generatorConfig->logStats) {
+      Generator::logStats("oatpp::swagger::Controller", *stats);
+    }
+
+    return controller;
+  }
+
+  /**
+   * Get statistics of the document generation.
+   * @return - &id:oatpp::swagger::Generator::Stats;. `nullptr` if the controller was constructed without stats.
+   */
+  std::shared_ptr<Generator::Stats> getStats() const {
+    return m_stats;
+  }
+
+  /**
+   * Get runtime metrics.
+   * @return - &id:oatpp::swagger::Metrics;. `nullptr` if &id:oatpp::swagger::Metrics; component is not registered.
+   */
+  std::shared_ptr<Metrics> getMetrics() const {
+    return m_metrics;
+  }
+
+  /**
+   * Get state of the currently served document.
+   * @return - &id:oatpp::swagger::DocumentState;.
+   */
+  std::shared_ptr<DocumentState> getState() const {
+    return std::atomic_load(&m_state);
+  }
+
+  /**
+   * Get history of the published documents.
+   * @return - &id:oatpp::swagger::DocumentHistory;.
+   */
+  std::shared_ptr<DocumentHistory> getHistory() const {
+    return m_history;
+  }
+
+  /**
+   * Publish new API document. Serialization, indexing and rendering of the UI pages happen in the calling thread,
+   * then the new state replaces the old one at once. Requests in flight finish with the previous document.
+   * @param document - &id:oatpp::swagger::oas3::Document;.
+   * @param generationMicros - time it took to generate the document, for &id:oatpp::swagger::Metrics;. `0` if unknown.
+   */
+  void setDocument(const oatpp::Object<oas3::Document>& document, v_int64 generationMicros = 0) {
+    auto state = std::make_shared<DocumentState>(m_objectMapper, document, *m_resources, m_paths, m_config);
+    std::lock_guard<std::mutex> lock(m_stateMutex);
+    m_history->push(state->getDocumentCache());
+    std::atomic_store(&m_state, state);
+    if(m_metrics) {
+      m_metrics->recordDocument(generationMicros, static_cast<v_int64>(state->getDocumentCache()->getData()->size()));
+    }
+  }
+
+  /**
+   * Record response in metrics (if enabled).
+   * @param endpoint - &id:oatpp::swagger::Metrics::Endpoint;.
+   * @param response - response to send.
+   * @return - the same response.
+   */
+  std::shared_ptr<OutgoingResponse> recordResponse(Metrics::Endpoint endpoint, const std::shared_ptr<OutgoingResponse>& response) const {
+    if(m_metrics) {
+      m_metrics->recordResponse(endpoint, response);
+    }
+    return response;
+  }
+
+  /**
+   * Get the API document. Same as the `api` endpoint for a request without conditional and range headers.
+   * @return - &id:oatpp::web::protocol::http::outgoing::Response;.
+   */
+  std::shared_ptr<OutgoingResponse> api() {
+    return api(nullptr);
+  }
+
+  /**
+   * Get Swagger-UI root page. Same as the `getUIRoot` endpoint for a request without conditional and range headers.
+   * @return - &id:oatpp::web::protocol::http::outgoing::Response;.
+   */
+  std::shared_ptr<OutgoingResponse> getUIRoot() {
+    return getUIRoot(nullptr);
+  }
+
+  /**
+   * Get `swagger-initializer.js`. Same as the `getInitializer` endpoint for a request without conditional and range headers.
+   * @return - &id:oatpp::web::protocol::http::outgoing::Response;.
+   */
+  std::shared_ptr<OutgoingResponse> getInitializer() {
+    return getInitializer(nullptr);
+  }
+
+  /**
+   * Get Swagger-UI resource. Same as the `getUIResource` endpoint for a request without conditional and range headers.
+   * @param filename - name of the resource file.
+   * @return - &id:oatpp::web::protocol::http::outgoing::Response;.
+   */
+  std::shared_ptr<OutgoingResponse> getUIResource(const oatpp::String& filename) {
+    return getUIResource(filename, nullptr);
+  }
+
+  /**
+   * Record request to the resource file in metrics (if enabled). Call only for the file which is actually served.
+   * @param filename - name of the resource file.
+   * @param resource - served resource. Counted as a cache hit if it is held in memory.
+   */
+  void recordFileRequest(const oatpp::String& filename, const std::shared_ptr<data::resource::Resource>& resource) const {
+    if(m_metrics) {
+      m_metrics->recordFileRequest(filename, resource->getInMemoryData() != nullptr);
+    }
+  }
+
+  /**
+   * Parse value of the `limit` query parameter. Responds with `400` if the value is not an integer in range `[1, maxLimit]`.
+   * @param param - value of the parameter. May be `nullptr`.
+   * @param defaultLimit - limit if the parameter is not set.
+   * @param maxLimit - max allowed limit.
+   * @return - limit.
+   */
+  static v_int32 parseLimit(const oatpp::String& param, v_int32 defaultLimit, v_int32 maxLimit) {
+    if(!param) {
+      return defaultLimit;
+    }
+    bool success;
+    auto limit = oatpp::utils::Conversion::strToInt32(param, success);
+    OATPP_ASSERT_HTTP(success && limit >= 1 && limit <= maxLimit, Status::CODE_400,
+                      "Invalid query parameter 'limit'. Expected integer in range [1, " + std::to_string(maxLimit) + "]")
+    return limit;
   }
   
 #include OATPP_CODEGEN_BEGIN(ApiController)
   
-  ENDPOINT("GET", m_paths.apiJson, api) {
-    return createDtoResponse(Status::CODE_200, m_document);
+  ENDPOINT("GET", m_paths.apiJson, api,
+           REQUEST(std::shared_ptr<IncomingRequest>, request))
+  {
+    auto state = getState();
+    auto resp = state->getPrebuiltResponses().getEndpoint(m_paths.apiJson, request);
+    if(!resp) {
+      const auto& document = state->getDocumentCache();
+      resp = ResponseFactory::createDataResponse(request, document->getData(), document->getETag(), "application/json");
+    }
+    return recordResponse(Metrics::Endpoint::API, resp);
   }
   
-  ENDPOINT("GET", m_paths.ui, getUIRoot) {
-    return createResponse(Status::CODE_200, m_resources->getResourceData("index.html"));
+  ENDPOINT("HEAD", m_paths.apiJson, headApi,
+           REQUEST(std::shared_ptr<IncomingRequest>, request))
+  {
+    auto state = getState();
+    return ResponseFactory::createHeadResponse(request,
+                                               static_cast<v_int64>(state->getDocumentCache()->getData()->size()),
+                                               state->getDocumentCache()->getETag(),
+                                               "application/json");
+  }
+
+  ENDPOINT("GET", m_paths.ui, getUIRoot,
+           REQUEST(std::shared_ptr<IncomingRequest>, request))
+  {
+    auto state = getState();
+    auto resp = state->getPrebuiltResponses().getEndpoint(m_paths.ui, request);
+    if(state->getUIRoot().data) {
+      // Rendered page - no file is served.
+      if(!resp) {
+        resp = ResponseFactory::createContentResponse(request, state->getUIRoot());
+      }
+      return recordResponse(Metrics::Endpoint::UI_ROOT, resp);
+    }
+    auto resource = m_resources->getResource("index.html");
+    recordFileRequest("index.html", resource);
+    if(!resp) {
+      auto info = m_resources->getResourceInfo("index.html");
+      resp = ResponseFactory::createResourceResponse(request,
+                                                     resource,
+                                                     info.size,
+                                                     info.etag,
+                                                     m_resources->getMimeType("index.html"));
+    }
+    return recordResponse(Metrics::Endpoint::UI_ROOT, resp);
   }
 
-  ENDPOINT("GET", m_paths.initializer, getInitializer) {
-    std::string ui = m_resources->getResourceData("swagger-initializer.js");
-    ui.replace(ui.find("%%API.JSON%%"), 12, m_paths.apiJson);
-    return createResponse(Status::CODE_200, ui);
+  ENDPOINT("GET", m_paths.apiTag, apiTag,
+           PATH(String, tag),
+           REQUEST(std::shared_ptr<IncomingRequest>, request))
+  {
+    auto state = getState();
+    auto document = state->getTagDocuments()->getDocument(oatpp::encoding::Url::decode(tag));
+    OATPP_ASSERT_HTTP(document, Status::CODE_404, "Tag not found")
+    auto resp = ResponseFactory::createDataResponse(request, document->getData(), document->getETag(), "application/json");
+    return recordResponse(Metrics::Endpoint::API_TAG, resp);
   }
-  
-  ENDPOINT("GET", m_paths.uiResources, getUIResource, PATH(String, filename)) {
-    auto body = std::make_shared<oatpp::web::protocol::http::outgoing::StreamingBody>(
-      m_resources->getResource(filename)->openInputStream()
-    );
-    auto resp = OutgoingResponse::createShared(Status::CODE_200, body);
-    resp->putHeader("Content-Type", m_resources->getMimeType(filename));
+
+  ENDPOINT("GET", m_paths.apiIndex, apiIndex,
+           REQUEST(std::shared_ptr<IncomingRequest>, request))
+  {
+    auto state = getState();
+    auto resp = state->getPrebuiltResponses().getEndpoint(m_paths.apiIndex, request);
+    if(!resp) {
+      auto index = state->getOperationIndex();
+      resp = ResponseFactory::createDataResponse(request, index->getData(), index->getETag(), "application/json");
+    }
+    return recordResponse(Metrics::Endpoint::API_INDEX, resp);
+  }
+
+  ENDPOINT("GET", m_paths.search, search,
+           REQUEST(std::shared_ptr<IncomingRequest>, request))
+  {
+    auto state = getState();
+    auto query = request->getQueryParameter("q");
+    OATPP_ASSERT_HTTP(query, Status::CODE_400, "Missing query parameter 'q'")
+    OATPP_ASSERT_HTTP(static_cast<v_buff_size>(query->size()) <= SearchIndex::MAX_QUERY_SIZE, Status::CODE_400, "Query is too long")
+    auto limit = parseLimit(request->getQueryParameter("limit"), SearchIndex::DEFAULT_LIMIT, SearchIndex::MAX_LIMIT);
+    auto resp = createDtoResponse(Status::CODE_200, state->getSearchIndex()->search(oatpp::encoding::Url::decode(query), limit));
+    return recordResponse(Metrics::Endpoint::SEARCH, resp);
+  }
+
+  ENDPOINT("GET", m_paths.fragment, fragment,
+           REQUEST(std::shared_ptr<IncomingRequest>, request))
+  {
+    auto state = getState();
+    auto pointer = request->getQueryParameter("ptr");
+    OATPP_ASSERT_HTTP(pointer, Status::CODE_400, "Missing query parameter 'ptr'")
+    auto content = state->getFragments()->getFragment(oatpp::encoding::Url::decode(pointer));
+    OATPP_ASSERT_HTTP(content.data, Status::CODE_404, "Fragment not found")
+    return recordResponse(Metrics::Endpoint::FRAGMENT, ResponseFactory::createContentResponse(request, content));
+  }
+
+  ENDPOINT("GET", m_paths.apiVersion, apiVersion,
+           PATH(String, version),
+           REQUEST(std::shared_ptr<IncomingRequest>, request))
+  {
+    auto content = m_history->getVersionContent(version);
+    OATPP_ASSERT_HTTP(content.data, Status::CODE_404, "Unknown document version")
+    return recordResponse(Metrics::Endpoint::API_VERSION, ResponseFactory::createContentResponse(request, content));
+  }
+
+  ENDPOINT("GET", m_paths.delta, delta,
+           REQUEST(std::shared_ptr<IncomingRequest>, request))
+  {
+    auto from = request->getQueryParameter("from");
+    OATPP_ASSERT_HTTP(from, Status::CODE_400, "Missing query parameter 'from'")
+    auto content = m_history->getPatch(from);
+    OATPP_ASSERT_HTTP(content.data, Status::CODE_404, "Unknown document version")
+    return recordResponse(Metrics::Endpoint::DELTA, ResponseFactory::createContentResponse(request, content));
+  }
+
+  ENDPOINT("HEAD", m_paths.ui, headUIRoot,
+           REQUEST(std::shared_ptr<IncomingRequest>, request))
+  {
+    auto state = getState();
+    std::shared_ptr<OutgoingResponse> resp;
+    if(state->getUIRoot().data) {
+      resp = ResponseFactory::createContentHeadResponse(request, state->getUIRoot());
+    } else {
+      auto info = m_resources->getResourceInfo("index.html");
+      resp = ResponseFactory::createHeadResponse(request,
+                                                 info.size,
+                                                 info.etag,
+                                                 m_resources->getMimeType("index.html"));
+    }
     return resp;
   }
+
+  ENDPOINT("GET", m_paths.initializer, getInitializer,
+           REQUEST(std::shared_ptr<IncomingRequest>, request))
+  {
+    auto state = getState();
+    auto resp = state->getPrebuiltResponses().getEndpoint(m_paths.initializer, request);
+    if(!resp) {
+      resp = ResponseFactory::createContentResponse(request, state->getInitializer());
+    }
+    return recordResponse(Metrics::Endpoint::INITIALIZER, resp);
+  }
+
+  ENDPOINT("HEAD", m_paths.initializer, headInitializer,
+           REQUEST(std::shared_ptr<IncomingRequest>, request))
+  {
+    auto state = getState();
+    return ResponseFactory::createContentHeadResponse(request, state->getInitializer());
+  }
+  
+  ENDPOINT("GET", m_paths.uiResources, getUIResource,
+           PATH(String, filename),
+           REQUEST(std::shared_ptr<IncomingRequest>, request))
+  {
+    auto state = getState();
+    auto resource = m_resources->findResource(filename);
+    OATPP_ASSERT_HTTP(resource, Status::CODE_404, "Resource not found")
+    recordFileRequest(filename, resource);
+    auto resp = state->getPrebuiltResponses().getResource(filename, request);
+    if(!resp) {
+      auto info = m_resources->getResourceInfo(filename);
+      resp = ResponseFactory::createResourceResponse(request,
+                                                     resource,
+                                                     info.size,
+                                                     info.etag,
+                                                     m_resources->getMimeType(filename));
+    }
+    return recordResponse(Metrics::Endpoint::UI_RESOURCE, resp);
+  }
+
+  ENDPOINT("HEAD", m_paths.uiResources, headUIResource,
+           PATH(String, filename),
+           REQUEST(std::shared_ptr<IncomingRequest>, request))
+  {
+    OATPP_ASSERT_HTTP(m_resources->findResource(filename), Status::CODE_404, "Resource not found")
+    auto info = m_resources->getResourceInfo(filename);
+    return ResponseFactory::createHeadResponse(request,
+                                               info.size,
+                                               info.etag,
+                                               m_resources->getMimeType(filename));
+  }
+
+  ENDPOINT("GET", m_paths.metrics, metrics) {
+    OATPP_ASSERT_HTTP(m_metrics, Status::CODE_404, "Metrics are not enabled")
+    auto resp = createResponse(Status::CODE_200, m_metrics->toPrometheusText());
+    resp->putHeader("Content-Type", "text/plain; version=0.0.4");
+    return recordResponse(Metrics::Endpoint::METRICS, resp);
+  }
+
+  ENDPOINT("GET", m_paths.sizeReport, sizeReport,
+           REQUEST(std::shared_ptr<IncomingRequest>, request))
+  {
+    OATPP_ASSERT_HTTP(m_config.sizeReport, Status::CODE_404, "Size report is not enabled")
+    auto state = getState();
+    auto limit = parseLimit(request->getQueryParameter("limit"), SizeAnalyzer::DEFAULT_LIMIT, SizeAnalyzer::MAX_LIMIT);
+    auto resp = createDtoResponse(Status::CODE_200, state->getSizeAnalyzer()->getReport(limit));
+    return recordResponse(Metrics::Endpoint::SIZE_REPORT, resp);
+  }
   
 #include OATPP_CODEGEN_END(ApiController)
   
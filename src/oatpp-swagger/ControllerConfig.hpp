@@ -0,0 +1,117 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi, <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef oatpp_swagger_ControllerConfig_hpp
+#define oatpp_swagger_ControllerConfig_hpp
+
+#include "oatpp/Types.hpp"
+
+namespace oatpp { namespace swagger {
+
+/**
+ * Swagger Controller serving options. <br>
+ * Register `std::shared_ptr<ControllerConfig>` as a component to override the defaults.
+ */
+struct ControllerConfig {
+
+  /**
+   * Assemble responses for the static content (spec, index.html, swagger-initializer.js, in-memory resources) once.
+   * Plain requests (without conditional or range headers) are answered with the prebuilt status, headers and body.
+   * See &id:oatpp::swagger::PrebuiltResponses;.
+   */
+  bool prebuiltResponses = false;
+
+  /**
+   * Embed the serialized API document into `swagger-initializer.js` as the `spec` config instead of the `url`.
+   * Saves the round trip to fetch the spec after the initializer is loaded at the cost of a larger initializer.
+   */
+  bool inlineSpec = false;
+
+  /**
+   * Add `<link rel="preload">` for the API document to `index.html`, so that the browser fetches the spec in parallel with the scripts.
+   * Not used if `inlineSpec == true`.
+   */
+  bool preloadSpec = false;
+
+  /**
+   * Inline small assets into `index.html`: stylesheets as `<style>`, icons as `data:` URIs and
+   * `swagger-initializer.js` as inline `<script>`. Assets larger than `inlineAssetMaxSize` are left as is.
+   */
+  bool inlineSmallAssets = false;
+
+  /**
+   * Max size of the asset in bytes to be inlined into `index.html`. Used only if `inlineSmallAssets == true`.
+   */
+  v_int64 inlineAssetMaxSize = 4096;
+
+  /**
+   * Add `Link: <...>; rel=preload` header to the `index.html` response for each stylesheet and script
+   * referenced by `index.html` (and for the spec if `preloadSpec == true`), so that the browser requests them in parallel.
+   */
+  bool preloadAssets = false;
+
+  /**
+   * Make Swagger-UI load one per-tag sub-document at a time instead of the whole API document. <br>
+   * `swagger-initializer.js` lists the tags as `urls`, each pointing to &id:oatpp::swagger::ControllerPaths::apiTag;.
+   * Ignored if `inlineSpec == true`.
+   */
+  bool splitByTag = false;
+
+  /**
+   * Make Swagger-UI load the API document from &id:oatpp::swagger::ControllerPaths::apiVersion; instead of
+   * &id:oatpp::swagger::ControllerPaths::apiJson;. The URL changes only when the document changes, so it can be cached forever.
+   * &id:oatpp::swagger::ControllerPaths::apiJson; keeps serving the current document.
+   */
+  bool contentAddressedSpec = false;
+
+  /**
+   * Number of recently published document versions (including the current one) to keep for the delta endpoint.
+   * See &id:oatpp::swagger::DocumentHistory;.
+   */
+  v_int64 documentHistorySize = 8;
+
+  /**
+   * Enable the Server-Sent Events stream about the published documents. See &id:oatpp::swagger::DocumentEvents;. <br>
+   * Served by &id:oatpp::swagger::AsyncController; only - each open stream is a long-lived connection.
+   */
+  bool events = false;
+
+  /**
+   * Interval between keep-alive comments of the events stream in milliseconds.
+   * See &id:oatpp::swagger::DocumentEvents;.
+   */
+  v_int64 eventsKeepAliveInterval = 15000;
+
+  /**
+   * Enable the debug endpoint with the size report of the API JSON. See &id:oatpp::swagger::SizeAnalyzer;. <br>
+   * The report is computed on the first request for each document.
+   */
+  bool sizeReport = false;
+
+};
+
+}}
+
+#endif //oatpp_swagger_ControllerConfig_hpp
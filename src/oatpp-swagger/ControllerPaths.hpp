@@ -39,6 +39,51 @@ struct ControllerPaths {
    */
   oatpp::String apiJson = "api-docs/oas-3.0.0.json";
 
+  /**
+   * Path to the per-tag sub-documents of the API JSON. MUST contain `{tag}` at the end. <br>
+   * See &id:oatpp::swagger::TagDocuments;.
+   */
+  oatpp::String apiTag = "api-docs/oas-3.0.0/tags/{tag}";
+
+  /**
+   * Path to the content-addressed API JSON. MUST contain `{version}` at the end. <br>
+   * `{version}` is `<version>.json`, where `<version>` is &id:oatpp::swagger::DocumentCache::getVersion ();.
+   * Served with `Cache-Control: immutable` for any version in &id:oatpp::swagger::DocumentHistory;.
+   */
+  oatpp::String apiVersion = "api-docs/oas-3.0.0/{version}";
+
+  /**
+   * Path to the compact index of all operations. See &id:oatpp::swagger::OperationIndex;.
+   */
+  oatpp::String apiIndex = "api-docs/index.json";
+
+  /**
+   * Path to the operation search. Query parameters: `q` - query, `limit` - max number of results (default 20).
+   * See &id:oatpp::swagger::SearchIndex;.
+   */
+  oatpp::String search = "api-docs/search";
+
+  /**
+   * Path to the sub-trees of the API JSON. Query parameter: `ptr` - JSON Pointer, ex.: `/components/schemas/UserDto`.
+   * See &id:oatpp::swagger::DocumentFragments;.
+   */
+  oatpp::String fragment = "api-docs/fragment";
+
+  /**
+   * Path to the JSON Patch (RFC 6902) from a previous version of the API JSON to the current one.
+   * Query parameter: `from` - version the client has (ETag of the API JSON without quotes).
+   * See &id:oatpp::swagger::DocumentHistory;.
+   */
+  oatpp::String delta = "api-docs/delta";
+
+  /**
+   * Path to the Server-Sent Events stream notifying about the published API documents.
+   * Query parameter: `delta=true` - include JSON Patch from the previous version in the events.
+   * Served by &id:oatpp::swagger::AsyncController; if &id:oatpp::swagger::ControllerConfig::events; is set.
+   * See &id:oatpp::swagger::DocumentEvents;.
+   */
+  oatpp::String events = "api-docs/events";
+
   /**
    * Path to swagger UI (index.html).
    */
@@ -54,6 +99,18 @@ struct ControllerPaths {
    */
   oatpp::String uiResources = "swagger/{filename}";
 
+  /**
+   * Path to metrics in Prometheus text format.
+   * Responds with `404` unless &id:oatpp::swagger::Metrics; component is registered.
+   */
+  oatpp::String metrics = "api-docs/metrics";
+
+  /**
+   * Path to the size report of the API JSON. Query parameter: `limit` - max number of entries in each list (default 20).
+   * See &id:oatpp::swagger::SizeAnalyzer;.
+   */
+  oatpp::String sizeReport = "api-docs/debug/size";
+
 };
 
 }}
@@ -0,0 +1,425 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi, <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "Deduplicator.hpp"
+
+#include <cstdio>
+
+namespace oatpp { namespace swagger {
+
+namespace {
+
+  template<class F>
+  void forEachOperation(const oatpp::Object<oas3::PathItem>& pathItem, const F& f) {
+    if(pathItem->operationGet) f(pathItem->operationGet);
+    if(pathItem->operationPut) f(pathItem->operationPut);
+    if(pathItem->operationPost) f(pathItem->operationPost);
+    if(pathItem->operationDelete) f(pathItem->operationDelete);
+    if(pathItem->operationOptions) f(pathItem->operationOptions);
+    if(pathItem->operationHead) f(pathItem->operationHead);
+    if(pathItem->operationPatch) f(pathItem->operationPatch);
+    if(pathItem->operationTrace) f(pathItem->operationTrace);
+  }
+
+}
+
+Deduplicator::Deduplicator(bool hoist, const std::unordered_set<const oas3::Schema*>& sharedSchemas)
+  : m_hoist(hoist)
+  , m_sharedSchemas(sharedSchemas)
+  , m_hoistedCount(0)
+{}
+
+void Deduplicator::appendToKey(std::string& key, const char* tag, const oatpp::String& value) {
+  if(value) {
+    key += tag;
+    key += std::to_string(value->size());
+    key += ':';
+    key += *value;
+  }
+}
+
+void Deduplicator::appendToKey(std::string& key, const char* tag, const oatpp::Object<oas3::Schema>& schema) {
+  if(schema) {
+    key += tag;
+    key += '#';
+    key += std::to_string(m_infos.at(schema.get()).id);
+    key += ';';
+  }
+}
+
+bool Deduplicator::isComplex(const oatpp::Object<oas3::Schema>& schema) {
+  return (schema->properties && schema->properties->size() > 0) ||
+         schema->items ||
+         schema->additionalProperties ||
+         schema->enumValues;
+}
+
+oatpp::String Deduplicator::getHoistedName(const std::string& key) {
+  // FNV-1a. Keeps names stable across processes for the same document.
+  v_uint64 hash = 14695981039346656037ULL;
+  for(char c : key) {
+    hash ^= static_cast<v_uint8>(c);
+    hash *= 1099511628211ULL;
+  }
+  char buffer[32];
+  std::snprintf(buffer, sizeof(buffer), "InlineSchema_%016llx", static_cast<unsigned long long>(hash));
+  return buffer;
+}
+
+oatpp::Object<oas3::Schema> Deduplicator::getMutableSchema(const oatpp::Object<oas3::Schema>& schema) {
+
+  if(m_sharedSchemas.find(schema.get()) == m_sharedSchemas.end()) {
+    return schema;
+  }
+
+  auto result = oas3::Schema::createShallowCopy(schema);
+  if(schema->properties) {
+    result->properties = oatpp::Fields<oatpp::Object<oas3::Schema>>::createShared();
+    for(auto& p : *schema->properties) {
+      result->properties->push_back(p);
+    }
+  }
+  return result;
+
+}
+
+oatpp::Object<oas3::Schema> Deduplicator::setChildren(const oatpp::Object<oas3::Schema>& schema,
+                                                      const std::vector<oatpp::Object<oas3::Schema>>& properties,
+                                                      const oatpp::Object<oas3::Schema>& additionalProperties,
+                                                      const oatpp::Object<oas3::Schema>& items)
+{
+
+  bool changed = additionalProperties.get() != schema->additionalProperties.get() || items.get() != schema->items.get();
+  if(schema->properties) {
+    auto it = properties.begin();
+    for(auto& p : *schema->properties) {
+      if((it ++)->get() != p.second.get()) {
+        changed = true;
+      }
+    }
+  }
+
+  if(!changed) {
+    return schema;
+  }
+
+  auto result = getMutableSchema(schema);
+  if(result->properties) {
+    auto it = properties.begin();
+    for(auto& p : *result->properties) {
+      p.second = *(it ++);
+    }
+  }
+  result->additionalProperties = additionalProperties;
+  result->items = items;
+  return result;
+
+}
+
+oatpp::Object<oas3::Schema> Deduplicator::deduplicate(const oatpp::Object<oas3::Schema>& schema) {
+
+  if(!schema) {
+    return schema;
+  }
+
+  auto visitedIt = m_visited.find(schema.get());
+  if(visitedIt != m_visited.end()) {
+    m_infos.at(visitedIt->second.get()).occurrences ++;
+    return visitedIt->second;
+  }
+
+  // Children first, so that the key of this schema refers to canonical children only.
+
+  std::vector<oatpp::Object<oas3::Schema>> properties;
+  if(schema->properties) {
+    for(auto& p : *schema->properties) {
+      properties.push_back(deduplicate(p.second));
+    }
+  }
+
+  auto additionalProperties = deduplicate(schema->additionalProperties);
+  auto items = deduplicate(schema->items);
+
+  auto result = setChildren(schema, properties, additionalProperties, items);
+
+  std::string key;
+  appendToKey(key, "t", result->type);
+  appendToKey(key, "f", result->format);
+  appendToKey(key, "d", result->description);
+  appendToKey(key, "p", result->pattern);
+  appendToKey(key, "r", result->ref);
+  if(result->minimum) key += "min" + std::to_string(*result->minimum) + ";";
+  if(result->maximum) key += "max" + std::to_string(*result->maximum) + ";";
+  if(result->uniqueItems) key += *result->uniqueItems ? "u1;" : "u0;";
+  if(result->defaultValue) appendToKey(key, "dv", m_objectMapper.writeToString(result->defaultValue));
+  if(result->enumValues) appendToKey(key, "e", m_objectMapper.writeToString(result->enumValues));
+  if(result->required) {
+    key += "req[";
+    for(auto& r : *result->required) appendToKey(key, "", r);
+    key += "]";
+  }
+  if(result->properties) {
+    key += "props{";
+    for(auto& p : *result->properties) {
+      appendToKey(key, "", p.first);
+      appendToKey(key, "", p.second);
+    }
+    key += "}";
+  }
+  appendToKey(key, "ap", result->additionalProperties);
+  appendToKey(key, "i", result->items);
+
+  m_retained.push_back(schema);
+
+  auto canonicalIt = m_canonical.find(key);
+  if(canonicalIt != m_canonical.end()) {
+    m_infos.at(canonicalIt->second.get()).occurrences ++;
+    m_visited[schema.get()] = canonicalIt->second;
+    return canonicalIt->second;
+  }
+
+  m_infos[result.get()] = {static_cast<v_int64>(m_canonical.size()), 1, key};
+  m_canonical[key] = result;
+  m_visited[schema.get()] = result;
+  return result;
+
+}
+
+oatpp::Object<oas3::MediaTypeObject> Deduplicator::deduplicate(const oatpp::Object<oas3::MediaTypeObject>& mediaType) {
+
+  if(!mediaType) {
+    return mediaType;
+  }
+
+  mediaType->schema = deduplicate(mediaType->schema);
+
+  if(mediaType->examples) {
+    return mediaType; // examples are not compared
+  }
+
+  std::string key;
+  appendToKey(key, "s", mediaType->schema);
+
+  auto it = m_mediaTypes.find(key);
+  if(it != m_mediaTypes.end()) {
+    return it->second;
+  }
+  m_mediaTypes[key] = mediaType;
+  return mediaType;
+
+}
+
+void Deduplicator::deduplicate(const oatpp::Fields<oatpp::Object<oas3::MediaTypeObject>>& content) {
+  if(content) {
+    for(auto& p : *content) {
+      p.second = deduplicate(p.second);
+    }
+  }
+}
+
+void Deduplicator::deduplicate(const oatpp::Object<oas3::PathItemOperation>& operation) {
+
+  if(operation->parameters) {
+    for(auto& parameter : *operation->parameters) {
+      parameter->schema = deduplicate(parameter->schema);
+    }
+  }
+
+  if(operation->requestBody) {
+    deduplicate(operation->requestBody->content);
+  }
+
+  if(operation->responses) {
+    for(auto& p : *operation->responses) {
+      deduplicate(p.second->content);
+    }
+  }
+
+}
+
+oatpp::Object<oas3::Schema> Deduplicator::hoist(const oatpp::Object<oas3::Schema>& schema) {
+
+  if(!schema) {
+    return schema;
+  }
+
+  auto hoistedIt = m_hoisted.find(schema.get());
+  if(hoistedIt != m_hoisted.end()) {
+    return hoistedIt->second;
+  }
+
+  auto infoIt = m_infos.find(schema.get());
+  if(infoIt != m_infos.end() && infoIt->second.occurrences > 1 && isComplex(schema)) {
+
+    oatpp::String name;
+    auto componentIt = m_componentNames.find(schema.get());
+    if(componentIt != m_componentNames.end()) {
+      name = componentIt->second;
+    } else {
+      name = getHoistedName(infoIt->second.key);
+      while(m_usedNames.find(name) != m_usedNames.end()) {
+        name = name + "_";
+      }
+      m_usedNames.insert(name);
+      m_componentNames[schema.get()] = name;
+      m_components->push_back({name, hoistChildren(schema)});
+      m_hoistedCount ++;
+    }
+
+    auto ref = oas3::Schema::createShared();
+    ref->ref = "#/components/schemas/" + name;
+    m_hoisted[schema.get()] = ref;
+    return ref;
+
+  }
+
+  return hoistChildren(schema);
+
+}
+
+oatpp::Object<oas3::Schema> Deduplicator::hoistChildren(const oatpp::Object<oas3::Schema>& schema) {
+
+  auto it = m_hoistedChildren.find(schema.get());
+  if(it != m_hoistedChildren.end()) {
+    return it->second;
+  }
+  m_hoistedChildren[schema.get()] = schema;
+
+  std::vector<oatpp::Object<oas3::Schema>> properties;
+  if(schema->properties) {
+    for(auto& p : *schema->properties) {
+      properties.push_back(hoist(p.second));
+    }
+  }
+
+  auto additionalProperties = hoist(schema->additionalProperties);
+  auto items = hoist(schema->items);
+
+  auto result = setChildren(schema, properties, additionalProperties, items);
+  m_hoistedChildren[schema.get()] = result;
+  return result;
+
+}
+
+void Deduplicator::hoist(const oatpp::Fields<oatpp::Object<oas3::MediaTypeObject>>& content) {
+  if(content) {
+    for(auto& p : *content) {
+      if(m_hoistedMediaTypes.insert(p.second.get()).second) {
+        p.second->schema = hoist(p.second->schema);
+      }
+    }
+  }
+}
+
+void Deduplicator::hoist(const oatpp::Object<oas3::PathItemOperation>& operation) {
+
+  if(operation->parameters) {
+    for(auto& parameter : *operation->parameters) {
+      parameter->schema = hoist(parameter->schema);
+    }
+  }
+
+  if(operation->requestBody) {
+    hoist(operation->requestBody->content);
+  }
+
+  if(operation->responses) {
+    for(auto& p : *operation->responses) {
+      hoist(p.second->content);
+    }
+  }
+
+}
+
+void Deduplicator::hoist(const oatpp::Object<oas3::Document>& document) {
+
+  if(!document->components) {
+    document->components = oas3::Components::createShared();
+  }
+  if(!document->components->schemas) {
+    document->components->schemas = oatpp::Fields<oatpp::Object<oas3::Schema>>::createShared();
+  }
+
+  m_components = document->components->schemas;
+
+  for(auto& p : *m_components) {
+    m_usedNames.insert(p.first);
+    if(m_componentNames.find(p.second.get()) == m_componentNames.end()) {
+      m_componentNames[p.second.get()] = p.first;
+    }
+  }
+
+  // Component definitions stay in place. Only their children may be replaced with references.
+  // Hoisted schemas are appended to the same list - visit only the definitions which were there before.
+  auto definitionsCount = m_components->size();
+  auto definition = m_components->begin();
+  for(size_t i = 0; i < definitionsCount; i ++, ++ definition) {
+    definition->second = hoistChildren(definition->second);
+  }
+
+  if(document->paths) {
+    for(auto& p : *document->paths) {
+      forEachOperation(p.second, [this](const oatpp::Object<oas3::PathItemOperation>& operation) {
+        hoist(operation);
+      });
+    }
+  }
+
+}
+
+void Deduplicator::deduplicate(const oatpp::Object<oas3::Document>& document) {
+
+  if(document->components && document->components->schemas) {
+    for(auto& p : *document->components->schemas) {
+      p.second = deduplicate(p.second);
+    }
+  }
+
+  if(document->paths) {
+    for(auto& p : *document->paths) {
+      forEachOperation(p.second, [this](const oatpp::Object<oas3::PathItemOperation>& operation) {
+        deduplicate(operation);
+      });
+    }
+  }
+
+  if(m_hoist) {
+    hoist(document);
+  }
+
+  m_visited.clear();
+  m_retained.clear();
+
+}
+
+v_int64 Deduplicator::getDistinctSchemasCount() const {
+  return static_cast<v_int64>(m_canonical.size());
+}
+
+v_int64 Deduplicator::getHoistedSchemasCount() const {
+  return m_hoistedCount;
+}
+
+}}
@@ -0,0 +1,135 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi, <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef oatpp_swagger_Deduplicator_hpp
+#define oatpp_swagger_Deduplicator_hpp
+
+#include "oatpp-swagger/oas3/Model.hpp"
+
+#include "oatpp/json/ObjectMapper.hpp"
+
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace oatpp { namespace swagger {
+
+/**
+ * Structural deduplication (hash-consing) of &id:oatpp::swagger::oas3::Schema; subtrees in the generated document. <br>
+ * Structurally equal schemas are replaced with one shared instance.
+ * Optionally, complex schemas which occur more than once are hoisted to `components/schemas` and referenced via `$ref`. <br>
+ * Schemas shared outside of the document (such as the simple-type schemas of &id:oatpp::swagger::Generator;) are never modified -
+ * they are copied before their children are replaced.
+ */
+class Deduplicator {
+private:
+
+  struct SchemaInfo {
+    v_int64 id;
+    v_int64 occurrences;
+    std::string key;
+  };
+
+private:
+  bool m_hoist;
+  std::unordered_set<const oas3::Schema*> m_sharedSchemas;
+  oatpp::json::ObjectMapper m_objectMapper;
+  std::unordered_map<const oas3::Schema*, oatpp::Object<oas3::Schema>> m_visited;
+  std::unordered_map<std::string, oatpp::Object<oas3::Schema>> m_canonical;
+  std::unordered_map<const oas3::Schema*, SchemaInfo> m_infos;
+  std::unordered_map<std::string, oatpp::Object<oas3::MediaTypeObject>> m_mediaTypes;
+  std::vector<oatpp::Object<oas3::Schema>> m_retained;
+private:
+  std::unordered_map<const oas3::Schema*, oatpp::Object<oas3::Schema>> m_hoisted;
+  std::unordered_map<const oas3::Schema*, oatpp::Object<oas3::Schema>> m_hoistedChildren;
+  std::unordered_map<const oas3::Schema*, oatpp::String> m_componentNames;
+  std::unordered_set<oatpp::String> m_usedNames;
+  std::unordered_set<const oas3::MediaTypeObject*> m_hoistedMediaTypes;
+  oatpp::Fields<oatpp::Object<oas3::Schema>> m_components;
+  v_int64 m_hoistedCount;
+private:
+  static void appendToKey(std::string& key, const char* tag, const oatpp::String& value);
+  void appendToKey(std::string& key, const char* tag, const oatpp::Object<oas3::Schema>& schema);
+  static bool isComplex(const oatpp::Object<oas3::Schema>& schema);
+  static oatpp::String getHoistedName(const std::string& key);
+private:
+
+  /*
+   * Returns a copy of the schema if it is a shared one, or the schema itself otherwise.
+   */
+  oatpp::Object<oas3::Schema> getMutableSchema(const oatpp::Object<oas3::Schema>& schema);
+
+  /*
+   * Replace children of the schema. The schema is copied first if it is a shared one.
+   */
+  oatpp::Object<oas3::Schema> setChildren(const oatpp::Object<oas3::Schema>& schema,
+                                          const std::vector<oatpp::Object<oas3::Schema>>& properties,
+                                          const oatpp::Object<oas3::Schema>& additionalProperties,
+                                          const oatpp::Object<oas3::Schema>& items);
+
+private:
+  oatpp::Object<oas3::Schema> deduplicate(const oatpp::Object<oas3::Schema>& schema);
+  oatpp::Object<oas3::MediaTypeObject> deduplicate(const oatpp::Object<oas3::MediaTypeObject>& mediaType);
+  void deduplicate(const oatpp::Fields<oatpp::Object<oas3::MediaTypeObject>>& content);
+  void deduplicate(const oatpp::Object<oas3::PathItemOperation>& operation);
+private:
+  oatpp::Object<oas3::Schema> hoist(const oatpp::Object<oas3::Schema>& schema);
+  oatpp::Object<oas3::Schema> hoistChildren(const oatpp::Object<oas3::Schema>& schema);
+  void hoist(const oatpp::Fields<oatpp::Object<oas3::MediaTypeObject>>& content);
+  void hoist(const oatpp::Object<oas3::PathItemOperation>& operation);
+  void hoist(const oatpp::Object<oas3::Document>& document);
+public:
+
+  /**
+   * Constructor.
+   * @param hoist - hoist complex schemas occurring more than once to `components/schemas`.
+   * @param sharedSchemas - schemas which must not be modified.
+   */
+  Deduplicator(bool hoist = false, const std::unordered_set<const oas3::Schema*>& sharedSchemas = {});
+
+  /**
+   * Deduplicate schemas of the document in-place.
+   * @param document - &id:oatpp::swagger::oas3::Document;.
+   */
+  void deduplicate(const oatpp::Object<oas3::Document>& document);
+
+  /**
+   * Get number of distinct schemas in the document after deduplication.
+   * @return
+   */
+  v_int64 getDistinctSchemasCount() const;
+
+  /**
+   * Get number of schemas hoisted to `components/schemas`.
+   * @return
+   */
+  v_int64 getHoistedSchemasCount() const;
+
+};
+
+}}
+
+#endif /* oatpp_swagger_Deduplicator_hpp */
@@ -0,0 +1,55 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi, <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "DocumentCache.hpp"
+
+#include "oatpp-swagger/ResponseFactory.hpp"
+
+namespace oatpp { namespace swagger {
+
+DocumentCache::DocumentCache(const std::shared_ptr<data::mapping::ObjectMapper>& objectMapper, const oatpp::Object<oas3::Document>& document)
+  : m_document(document)
+  , m_data(objectMapper->writeToString(document))
+  , m_etag(ResponseFactory::createETag(m_data->data(), static_cast<v_buff_size>(m_data->size())))
+  , m_version(m_etag->substr(1, m_etag->size() - 2))
+{}
+
+oatpp::Object<oas3::Document> DocumentCache::getDocument() const {
+  return m_document;
+}
+
+oatpp::String DocumentCache::getData() const {
+  return m_data;
+}
+
+oatpp::String DocumentCache::getETag() const {
+  return m_etag;
+}
+
+oatpp::String DocumentCache::getVersion() const {
+  return m_version;
+}
+
+}}
@@ -0,0 +1,83 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi, <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef oatpp_swagger_DocumentCache_hpp
+#define oatpp_swagger_DocumentCache_hpp
+
+#include "oatpp-swagger/oas3/Model.hpp"
+
+#include "oatpp/data/mapping/ObjectMapper.hpp"
+
+namespace oatpp { namespace swagger {
+
+/**
+ * Serialized API document. <br>
+ * The document is serialized once and the same bytes are served to every request,
+ * together with the ETag computed from them.
+ */
+class DocumentCache {
+private:
+  oatpp::Object<oas3::Document> m_document;
+  oatpp::String m_data;
+  oatpp::String m_etag;
+  oatpp::String m_version;
+public:
+
+  /**
+   * Constructor. Serializes the document.
+   * @param objectMapper - &id:oatpp::data::mapping::ObjectMapper; to serialize the document with.
+   * @param document - &id:oatpp::swagger::oas3::Document;.
+   */
+  DocumentCache(const std::shared_ptr<data::mapping::ObjectMapper>& objectMapper, const oatpp::Object<oas3::Document>& document);
+
+  /**
+   * Get document.
+   * @return - &id:oatpp::swagger::oas3::Document;.
+   */
+  oatpp::Object<oas3::Document> getDocument() const;
+
+  /**
+   * Get serialized document.
+   * @return
+   */
+  oatpp::String getData() const;
+
+  /**
+   * Get ETag of the serialized document.
+   * @return - quoted ETag.
+   */
+  oatpp::String getETag() const;
+
+  /**
+   * Get version of the document - content hash of the serialized document. Same as the ETag without quotes.
+   * @return - version.
+   */
+  oatpp::String getVersion() const;
+
+};
+
+}}
+
+#endif // oatpp_swagger_DocumentCache_hpp
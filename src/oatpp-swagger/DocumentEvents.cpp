@@ -0,0 +1,200 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi, <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "DocumentEvents.hpp"
+
+#include <cstring>
+
+namespace oatpp { namespace swagger {
+
+DocumentEvents::Subscription::Subscription(const std::shared_ptr<DocumentEvents>& events,
+                                           bool includePatch,
+                                           const oatpp::String& lastVersion)
+  : m_events(events)
+  , m_includePatch(includePatch)
+  , m_version(lastVersion)
+  , m_position(0)
+  , m_waiting(false)
+{
+  m_events->m_subscribersCount ++;
+}
+
+DocumentEvents::Subscription::~Subscription() {
+  m_events->m_subscribersCount --;
+}
+
+void DocumentEvents::Subscription::writeEvent(const oatpp::String& version) {
+
+  m_buffer.append("id: ").append(*version).append("\n");
+  m_buffer.append("event: document\n");
+  m_buffer.append("data: {\"version\":\"").append(*version).append("\"");
+
+  if(m_version) {
+    m_buffer.append(",\"previous\":\"").append(*m_version).append("\"");
+    if(m_includePatch) {
+      auto patch = m_events->m_history->getPatch(m_version);
+      // The patch leads to the latest version in the history which may be newer than `version` by now.
+      if(patch.data && !patch.headers.empty() && patch.headers[0].second == version) {
+        m_buffer.append(",\"patch\":").append(*patch.data);
+      }
+    }
+  }
+
+  m_buffer.append("}\n\n");
+
+  m_version = version;
+
+}
+
+void DocumentEvents::Subscription::writeKeepAlive() {
+  m_buffer.append(": keep-alive\n\n");
+}
+
+v_io_size DocumentEvents::Subscription::read(void *buffer, v_buff_size count, async::Action& action) {
+
+  if(m_position >= m_buffer.size()) {
+
+    m_buffer.clear();
+    m_position = 0;
+
+    oatpp::String version;
+
+    {
+      std::lock_guard<std::mutex> lock(m_events->m_mutex);
+
+      auto hasEvent = [this] {
+        return m_events->m_closed || (m_events->m_version && m_events->m_version != m_version);
+      };
+
+      if(!hasEvent() && !m_waiting) {
+        // Suspend the coroutine until the next publish or the keep-alive deadline.
+        // The coroutine is put to the wait list after this call returns - see DocumentEvents::onNewItem.
+        m_waiting = true;
+        m_events->m_enqueuing ++;
+        action = async::Action::createWaitListActionWithTimeout(&m_events->m_waitList,
+                                                                std::chrono::steady_clock::now() + m_events->m_keepAliveInterval);
+        return IOError::RETRY_READ;
+      }
+
+      m_waiting = false;
+
+      if(m_events->m_closed) {
+        return 0;
+      }
+
+      if(hasEvent()) {
+        version = m_events->m_version;
+      }
+
+    }
+
+    if(version) {
+      writeEvent(version);
+    } else {
+      writeKeepAlive();
+    }
+
+  }
+
+  auto available = static_cast<v_buff_size>(m_buffer.size() - m_position);
+  if(count > available) {
+    count = available;
+  }
+
+  std::memcpy(buffer, m_buffer.data() + m_position, static_cast<size_t>(count));
+  m_position += static_cast<size_t>(count);
+
+  return count;
+
+}
+
+DocumentEvents::DocumentEvents(const std::shared_ptr<DocumentHistory>& history, v_int64 keepAliveInterval)
+  : m_history(history)
+  , m_keepAliveInterval(keepAliveInterval > 0 ? keepAliveInterval : DEFAULT_KEEP_ALIVE_INTERVAL)
+  , m_subscribersCount(0)
+  , m_closed(false)
+  , m_enqueuing(0)
+  , m_missedNotify(false)
+{
+  m_waitList.setListener(this);
+}
+
+DocumentEvents::~DocumentEvents() {
+  m_waitList.setListener(nullptr);
+}
+
+void DocumentEvents::onNewItem(async::CoroutineWaitList& list) {
+
+  // Re-check after the coroutine is on the wait list: an event published between the decision
+  // to wait and the enqueueing has notified the list before the coroutine was on it.
+  bool notify = false;
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if(m_enqueuing > 0) {
+      m_enqueuing --;
+    }
+    notify = m_missedNotify;
+    if(m_enqueuing == 0) {
+      m_missedNotify = false;
+    }
+  }
+
+  if(notify) {
+    list.notifyAll();
+  }
+
+}
+
+void DocumentEvents::publish(const oatpp::String& version) {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if(m_version == version) {
+      return;
+    }
+    m_version = version;
+    m_missedNotify = m_enqueuing > 0;
+  }
+  m_waitList.notifyAll();
+}
+
+void DocumentEvents::close() {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_closed = true;
+    m_missedNotify = m_enqueuing > 0;
+  }
+  m_waitList.notifyAll();
+}
+
+std::shared_ptr<DocumentEvents::Subscription> DocumentEvents::subscribe(bool includePatch, const oatpp::String& lastVersion) {
+  return std::make_shared<Subscription>(shared_from_this(), includePatch, lastVersion);
+}
+
+v_int64 DocumentEvents::getSubscribersCount() const {
+  return m_subscribersCount.load();
+}
+
+}}
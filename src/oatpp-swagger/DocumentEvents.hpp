@@ -0,0 +1,163 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi, <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef oatpp_swagger_DocumentEvents_hpp
+#define oatpp_swagger_DocumentEvents_hpp
+
+#include "oatpp-swagger/DocumentHistory.hpp"
+
+#include "oatpp/async/CoroutineWaitList.hpp"
+#include "oatpp/data/stream/Stream.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+
+namespace oatpp { namespace swagger {
+
+/**
+ * Server-Sent Events about the published API documents. <br>
+ * Each subscriber receives a `document` event with the current version right away (unless it already has it)
+ * and then one event per published document. Subscribers that were slow to read get only the latest version. <br>
+ * Event format:
+ * <pre>
+ * id: {version}
+ * event: document
+ * data: {"version":"{version}","previous":"{previous version}","patch":[...]}
+ * </pre>
+ * `patch` is the JSON Patch (RFC 6902) from the previous version and is present only if requested and
+ * the previous version is still in &id:oatpp::swagger::DocumentHistory;.
+ * A comment line is sent if no event happened during the keep-alive interval. <br>
+ * Subscriptions are read by coroutines only - a waiting subscriber is suspended on the events wait list and takes no thread.
+ */
+class DocumentEvents : public std::enable_shared_from_this<DocumentEvents>, private async::CoroutineWaitList::Listener {
+public:
+
+  /**
+   * Default interval between keep-alive comments in milliseconds.
+   */
+  static constexpr v_int64 DEFAULT_KEEP_ALIVE_INTERVAL = 15000;
+
+public:
+
+  /**
+   * Event stream of one subscriber. Use as a body of the response via &id:oatpp::web::protocol::http::outgoing::StreamingBody;.
+   */
+  class Subscription : public data::stream::ReadCallback {
+  private:
+    std::shared_ptr<DocumentEvents> m_events;
+    bool m_includePatch;
+    oatpp::String m_version;
+    std::string m_buffer;
+    size_t m_position;
+    bool m_waiting;
+  private:
+    void writeEvent(const oatpp::String& version);
+    void writeKeepAlive();
+  public:
+
+    /**
+     * Constructor.
+     * @param events - &l:DocumentEvents;.
+     * @param includePatch - include JSON Patch from the previous version in the events.
+     * @param lastVersion - version the subscriber already has (ex.: from the `Last-Event-ID` header). May be `nullptr`.
+     */
+    Subscription(const std::shared_ptr<DocumentEvents>& events, bool includePatch, const oatpp::String& lastVersion);
+
+    /**
+     * Non-virtual destructor.
+     */
+    ~Subscription() override;
+
+    /**
+     * Read the event stream. If there is nothing to send, sets `action` to wait on the events wait list until the next event
+     * or the keep-alive deadline and returns &id:oatpp::IOError::RETRY_READ;.
+     * @param buffer - pointer to buffer.
+     * @param count - size of the buffer in bytes.
+     * @param action - async specific action.
+     * @return - actual number of bytes written to buffer. 0 - the events are closed.
+     */
+    v_io_size read(void *buffer, v_buff_size count, async::Action& action) override;
+
+  };
+
+private:
+  std::shared_ptr<DocumentHistory> m_history;
+  std::chrono::milliseconds m_keepAliveInterval;
+  std::atomic<v_int64> m_subscribersCount;
+private:
+  std::mutex m_mutex;
+  async::CoroutineWaitList m_waitList;
+  oatpp::String m_version;
+  bool m_closed;
+  v_int64 m_enqueuing;
+  bool m_missedNotify;
+private:
+  void onNewItem(async::CoroutineWaitList& list) override;
+public:
+
+  /**
+   * Constructor.
+   * @param history - &id:oatpp::swagger::DocumentHistory; to take patches from.
+   * @param keepAliveInterval - interval between keep-alive comments in milliseconds.
+   */
+  DocumentEvents(const std::shared_ptr<DocumentHistory>& history, v_int64 keepAliveInterval = DEFAULT_KEEP_ALIVE_INTERVAL);
+
+  /**
+   * Virtual destructor.
+   */
+  ~DocumentEvents() override;
+
+  /**
+   * Notify subscribers about the new document version. Does nothing if the version is the current one.
+   * @param version - version of the published document.
+   */
+  void publish(const oatpp::String& version);
+
+  /**
+   * End all event streams. New subscriptions end right away.
+   */
+  void close();
+
+  /**
+   * Subscribe to events.
+   * @param includePatch - include JSON Patch from the previous version in the events.
+   * @param lastVersion - version the subscriber already has. May be `nullptr`.
+   * @return - &l:DocumentEvents::Subscription;.
+   */
+  std::shared_ptr<Subscription> subscribe(bool includePatch, const oatpp::String& lastVersion);
+
+  /**
+   * Get number of open subscriptions.
+   * @return
+   */
+  v_int64 getSubscribersCount() const;
+
+};
+
+}}
+
+#endif // oatpp_swagger_DocumentEvents_hpp
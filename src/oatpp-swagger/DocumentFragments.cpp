@@ -0,0 +1,231 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi, <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "DocumentFragments.hpp"
+
+#include <cctype>
+
+namespace oatpp { namespace swagger {
+
+DocumentFragments::DocumentFragments(const std::shared_ptr<data::mapping::ObjectMapper>& objectMapper,
+                                     const oatpp::Object<oas3::Document>& document,
+                                     v_int64 maxCachedFragments)
+  : m_objectMapper(objectMapper)
+  , m_document(document)
+  , m_maxCachedFragments(maxCachedFragments)
+{
+
+  if(m_document->paths) {
+    for(auto& path : *m_document->paths) {
+      m_paths[path.first] = path.second;
+    }
+  }
+
+  if(m_document->components && m_document->components->schemas) {
+    for(auto& schema : *m_document->components->schemas) {
+      m_schemas[schema.first] = schema.second;
+    }
+  }
+
+}
+
+bool DocumentFragments::parsePointer(const oatpp::String& pointer, std::vector<std::string>& tokens) {
+
+  if(!pointer || pointer->empty() || pointer->at(0) != '/') {
+    return false;
+  }
+
+  std::string token;
+
+  for(size_t i = 1; i <= pointer->size(); i++) {
+
+    if(i == pointer->size() || pointer->at(i) == '/') {
+      tokens.push_back(token);
+      token.clear();
+      continue;
+    }
+
+    char c = pointer->at(i);
+    if(c == '~') {
+      if(i + 1 >= pointer->size()) {
+        return false;
+      }
+      char e = pointer->at(++i);
+      if(e == '0') token.push_back('~');
+      else if(e == '1') token.push_back('/');
+      else return false;
+    } else {
+      token.push_back(c);
+    }
+
+  }
+
+  return true;
+
+}
+
+std::string DocumentFragments::escapeToken(const std::string& token) {
+  std::string result;
+  result.reserve(token.size());
+  for(char c : token) {
+    if(c == '~') {
+      result.append("~0");
+    } else if(c == '/') {
+      result.append("~1");
+    } else {
+      result.push_back(c);
+    }
+  }
+  return result;
+}
+
+oatpp::Void DocumentFragments::getChild(const oatpp::Void& node, const std::string& token) {
+
+  if(!node) {
+    return nullptr;
+  }
+
+  auto type = node.getValueType();
+
+  if(type->classId.id == oatpp::data::type::__class::AbstractObject::CLASS_ID.id) {
+    auto dispatcher = static_cast<const oatpp::data::type::__class::AbstractObject::PolymorphicDispatcher*>(type->polymorphicDispatcher);
+    const auto& properties = dispatcher->getProperties()->getMap();
+    auto it = properties.find(token);
+    if(it == properties.end()) {
+      return nullptr;
+    }
+    return it->second->get(static_cast<oatpp::BaseObject*>(node.get()));
+  }
+
+  if(type->classId.id == oatpp::data::type::__class::AbstractList::CLASS_ID.id ||
+     type->classId.id == oatpp::data::type::__class::AbstractVector::CLASS_ID.id)
+  {
+    if(token.empty() || token.size() > 9 || (token.size() > 1 && token[0] == '0')) {
+      return nullptr;
+    }
+    for(char c : token) {
+      if(!std::isdigit(static_cast<unsigned char>(c))) {
+        return nullptr;
+      }
+    }
+    auto index = std::stoul(token);
+    auto dispatcher = static_cast<const oatpp::data::type::__class::Collection::PolymorphicDispatcher*>(type->polymorphicDispatcher);
+    auto iterator = dispatcher->beginIteration(node);
+    for(unsigned long i = 0; !iterator->finished(); i++, iterator->next()) {
+      if(i == index) {
+        return iterator->get();
+      }
+    }
+    return nullptr;
+  }
+
+  if(type->classId.id == oatpp::data::type::__class::AbstractPairList::CLASS_ID.id ||
+     type->classId.id == oatpp::data::type::__class::AbstractUnorderedMap::CLASS_ID.id)
+  {
+    auto dispatcher = static_cast<const oatpp::data::type::__class::Map::PolymorphicDispatcher*>(type->polymorphicDispatcher);
+    auto iterator = dispatcher->beginIteration(node);
+    for(; !iterator->finished(); iterator->next()) {
+      auto key = iterator->getKey();
+      if(key && *static_cast<std::string*>(key.get()) == token) {
+        return iterator->getValue();
+      }
+    }
+    return nullptr;
+  }
+
+  return nullptr;
+
+}
+
+oatpp::Void DocumentFragments::resolve(const oatpp::String& pointer) const {
+
+  std::vector<std::string> tokens;
+  if(!parsePointer(pointer, tokens)) {
+    return nullptr;
+  }
+
+  oatpp::Void node = m_document;
+  size_t i = 0;
+
+  if(tokens.size() >= 2 && tokens[0] == "paths") {
+    auto it = m_paths.find(tokens[1]);
+    if(it == m_paths.end()) {
+      return nullptr;
+    }
+    node = it->second;
+    i = 2;
+  } else if(tokens.size() >= 3 && tokens[0] == "components" && tokens[1] == "schemas") {
+    auto it = m_schemas.find(tokens[2]);
+    if(it == m_schemas.end()) {
+      return nullptr;
+    }
+    node = it->second;
+    i = 3;
+  }
+
+  for(; i < tokens.size() && node; i++) {
+    node = getChild(node, tokens[i]);
+  }
+
+  return node;
+
+}
+
+ResponseFactory::Content DocumentFragments::getFragment(const oatpp::String& pointer) {
+
+  if(!pointer) {
+    return ResponseFactory::Content();
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_fragments.find(*pointer);
+    if(it != m_fragments.end()) {
+      return it->second;
+    }
+  }
+
+  auto node = resolve(pointer);
+  if(!node) {
+    return ResponseFactory::Content();
+  }
+
+  auto content = ResponseFactory::createContent(m_objectMapper->writeToString(node), "application/json");
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if(static_cast<v_int64>(m_fragments.size()) < m_maxCachedFragments) {
+    m_fragments.emplace(*pointer, content);
+  }
+
+  return content;
+
+}
+
+v_int64 DocumentFragments::getCachedFragmentsCount() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return static_cast<v_int64>(m_fragments.size());
+}
+
+}}
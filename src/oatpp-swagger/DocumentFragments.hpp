@@ -0,0 +1,115 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi, <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef oatpp_swagger_DocumentFragments_hpp
+#define oatpp_swagger_DocumentFragments_hpp
+
+#include "oatpp-swagger/ResponseFactory.hpp"
+#include "oatpp-swagger/oas3/Model.hpp"
+
+#include "oatpp/data/mapping/ObjectMapper.hpp"
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace oatpp { namespace swagger {
+
+/**
+ * Sub-trees of the API document addressed by JSON Pointer (RFC 6901). Ex.: `/components/schemas/UserDto`, `/paths/~1users/get`. <br>
+ * Lookups of `paths` and `components/schemas` entries are O(1). Serialized fragments are cached after the first access.
+ */
+class DocumentFragments {
+public:
+
+  /**
+   * Default max number of cached fragments. Fragments requested after the cache is full are serialized on each request.
+   */
+  static constexpr v_int64 DEFAULT_MAX_CACHED_FRAGMENTS = 4096;
+
+private:
+  static oatpp::Void getChild(const oatpp::Void& node, const std::string& token);
+private:
+  std::shared_ptr<data::mapping::ObjectMapper> m_objectMapper;
+  oatpp::Object<oas3::Document> m_document;
+  std::unordered_map<oatpp::String, oatpp::Object<oas3::PathItem>> m_paths;
+  std::unordered_map<oatpp::String, oatpp::Object<oas3::Schema>> m_schemas;
+  v_int64 m_maxCachedFragments;
+private:
+  mutable std::mutex m_mutex;
+  std::unordered_map<std::string, ResponseFactory::Content> m_fragments;
+public:
+
+  /**
+   * Constructor.
+   * @param objectMapper - &id:oatpp::data::mapping::ObjectMapper; to serialize fragments with.
+   * @param document - &id:oatpp::swagger::oas3::Document;.
+   * @param maxCachedFragments - max number of cached fragments.
+   */
+  DocumentFragments(const std::shared_ptr<data::mapping::ObjectMapper>& objectMapper,
+                    const oatpp::Object<oas3::Document>& document,
+                    v_int64 maxCachedFragments = DEFAULT_MAX_CACHED_FRAGMENTS);
+
+  /**
+   * Escape JSON Pointer reference token - `~` to `~0`, `/` to `~1`.
+   * @param token - reference token.
+   * @return - escaped token.
+   */
+  static std::string escapeToken(const std::string& token);
+
+  /**
+   * Split JSON Pointer into unescaped reference tokens.
+   * @param pointer - JSON Pointer. MUST start with `/`.
+   * @param tokens - out. Reference tokens.
+   * @return - `false` if the pointer is malformed.
+   */
+  static bool parsePointer(const oatpp::String& pointer, std::vector<std::string>& tokens);
+
+  /**
+   * Find the sub-tree of the document.
+   * @param pointer - JSON Pointer.
+   * @return - node of the document or `nullptr` if the pointer is malformed or there is no such node.
+   */
+  oatpp::Void resolve(const oatpp::String& pointer) const;
+
+  /**
+   * Get serialized sub-tree of the document.
+   * @param pointer - JSON Pointer.
+   * @return - &id:oatpp::swagger::ResponseFactory::Content;. `data` is `nullptr` if there is no such node.
+   */
+  ResponseFactory::Content getFragment(const oatpp::String& pointer);
+
+  /**
+   * Get number of cached fragments.
+   * @return - number of cached fragments.
+   */
+  v_int64 getCachedFragmentsCount() const;
+
+};
+
+}}
+
+#endif // oatpp_swagger_DocumentFragments_hpp
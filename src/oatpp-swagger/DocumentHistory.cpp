@@ -0,0 +1,155 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi, <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "DocumentHistory.hpp"
+
+#include "oatpp-swagger/JsonPatch.hpp"
+
+namespace oatpp { namespace swagger {
+
+DocumentHistory::DocumentHistory(const std::shared_ptr<data::mapping::ObjectMapper>& objectMapper, v_int64 maxVersions)
+  : m_objectMapper(objectMapper)
+  , m_maxVersions(maxVersions < 1 ? 1 : maxVersions)
+{}
+
+void DocumentHistory::push(const std::shared_ptr<DocumentCache>& document) {
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  if(!m_versions.empty() && m_versions.front()->getVersion() == document->getVersion()) {
+    return;
+  }
+
+  m_versions.remove_if([&document](const std::shared_ptr<DocumentCache>& version) {
+    return version->getVersion() == document->getVersion();
+  });
+
+  m_versions.push_front(document);
+  while(static_cast<v_int64>(m_versions.size()) > m_maxVersions) {
+    m_versions.pop_back();
+  }
+
+  m_patches.clear();
+
+}
+
+oatpp::String DocumentHistory::getCurrentVersion() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if(m_versions.empty()) {
+    return nullptr;
+  }
+  return m_versions.front()->getVersion();
+}
+
+std::vector<oatpp::String> DocumentHistory::getVersions() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  std::vector<oatpp::String> result;
+  for(auto& version : m_versions) {
+    result.push_back(version->getVersion());
+  }
+  return result;
+}
+
+std::shared_ptr<DocumentCache> DocumentHistory::getDocument(const oatpp::String& version) const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  for(auto& document : m_versions) {
+    if(document->getVersion() == version) {
+      return document;
+    }
+  }
+  return nullptr;
+}
+
+ResponseFactory::Content DocumentHistory::getVersionContent(const oatpp::String& filename) const {
+
+  static const std::string SUFFIX = ".json";
+
+  if(!filename || filename->size() <= SUFFIX.size() ||
+     filename->compare(filename->size() - SUFFIX.size(), SUFFIX.size(), SUFFIX) != 0)
+  {
+    return ResponseFactory::Content();
+  }
+
+  auto document = getDocument(filename->substr(0, filename->size() - SUFFIX.size()));
+  if(!document) {
+    return ResponseFactory::Content();
+  }
+
+  ResponseFactory::Content content {document->getData(), document->getETag(), "application/json"};
+  content.headers.push_back({"Cache-Control", "public, max-age=31536000, immutable"});
+  return content;
+
+}
+
+ResponseFactory::Content DocumentHistory::getPatch(const oatpp::String& fromVersion) {
+
+  std::shared_ptr<DocumentCache> from;
+  std::shared_ptr<DocumentCache> current;
+
+  {
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if(!fromVersion || m_versions.empty()) {
+      return ResponseFactory::Content();
+    }
+
+    auto cached = m_patches.find(fromVersion);
+    if(cached != m_patches.end()) {
+      return cached->second;
+    }
+
+    for(auto& version : m_versions) {
+      if(version->getVersion() == fromVersion) {
+        from = version;
+        break;
+      }
+    }
+
+    if(!from) {
+      return ResponseFactory::Content();
+    }
+
+    current = m_versions.front();
+
+  }
+
+  // Diff of large documents takes a while - compute it without blocking other requests and publishing.
+  JsonPatch patch(m_objectMapper, from->getDocument(), current->getDocument());
+  auto content = ResponseFactory::createContent(patch.toString(), "application/json-patch+json");
+  content.headers.push_back({HEADER_DOCUMENT_VERSION, current->getVersion()});
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  // Cache only if no newer document was published meanwhile. Keep the patch cached by a concurrent request if there is one.
+  if(!m_versions.empty() && m_versions.front() == current) {
+    return m_patches.emplace(fromVersion, content).first->second;
+  }
+
+  return content;
+
+}
+
+}}
@@ -0,0 +1,117 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi, <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef oatpp_swagger_DocumentHistory_hpp
+#define oatpp_swagger_DocumentHistory_hpp
+
+#include "oatpp-swagger/DocumentCache.hpp"
+#include "oatpp-swagger/ResponseFactory.hpp"
+
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace oatpp { namespace swagger {
+
+/**
+ * Bounded history of the recently published API documents, identified by &id:oatpp::swagger::DocumentCache::getVersion ();. <br>
+ * Provides JSON Patch (RFC 6902) from any version in the history to the current one.
+ * Each patch is computed once, outside of the lock, and cached until the next document is published.
+ */
+class DocumentHistory {
+public:
+
+  /**
+   * Default number of document versions to keep (including the current one).
+   */
+  static constexpr v_int64 DEFAULT_MAX_VERSIONS = 8;
+
+  /**
+   * Response header with the version of the document the patch leads to.
+   */
+  static constexpr const char* const HEADER_DOCUMENT_VERSION = "X-Document-Version";
+
+private:
+  std::shared_ptr<data::mapping::ObjectMapper> m_objectMapper;
+  v_int64 m_maxVersions;
+private:
+  mutable std::mutex m_mutex;
+  std::list<std::shared_ptr<DocumentCache>> m_versions; // newest first
+  std::unordered_map<oatpp::String, ResponseFactory::Content> m_patches; // from version -> patch to the current version
+public:
+
+  /**
+   * Constructor.
+   * @param objectMapper - &id:oatpp::data::mapping::ObjectMapper; to serialize patches with.
+   * @param maxVersions - number of document versions to keep (including the current one).
+   */
+  DocumentHistory(const std::shared_ptr<data::mapping::ObjectMapper>& objectMapper, v_int64 maxVersions = DEFAULT_MAX_VERSIONS);
+
+  /**
+   * Make the document the current version. The oldest version is dropped if the history is full.
+   * @param document - &id:oatpp::swagger::DocumentCache;.
+   */
+  void push(const std::shared_ptr<DocumentCache>& document);
+
+  /**
+   * Get current version.
+   * @return - current version or `nullptr` if the history is empty.
+   */
+  oatpp::String getCurrentVersion() const;
+
+  /**
+   * Get versions in the history, newest first.
+   * @return - list of versions.
+   */
+  std::vector<oatpp::String> getVersions() const;
+
+  /**
+   * Get document of the version.
+   * @param version - version of the document.
+   * @return - &id:oatpp::swagger::DocumentCache; or `nullptr` if the version is not in the history.
+   */
+  std::shared_ptr<DocumentCache> getDocument(const oatpp::String& version) const;
+
+  /**
+   * Get content-addressed document. Content of a version never changes, so it is served with `Cache-Control: immutable`.
+   * @param filename - `<version>.json`. See &id:oatpp::swagger::ControllerPaths::apiVersion;.
+   * @return - &id:oatpp::swagger::ResponseFactory::Content;. `data` is `nullptr` if the version is not in the history.
+   */
+  ResponseFactory::Content getVersionContent(const oatpp::String& filename) const;
+
+  /**
+   * Get JSON Patch from the version to the current version.
+   * @param fromVersion - version the client has.
+   * @return - &id:oatpp::swagger::ResponseFactory::Content; with the `X-Document-Version` header.
+   * `data` is `nullptr` if the version is not in the history.
+   */
+  ResponseFactory::Content getPatch(const oatpp::String& fromVersion);
+
+};
+
+}}
+
+#endif // oatpp_swagger_DocumentHistory_hpp
@@ -0,0 +1,148 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi, <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "DocumentState.hpp"
+
+#include "oatpp-swagger/UiRenderer.hpp"
+
+namespace oatpp { namespace swagger {
+
+DocumentState::DocumentState(const std::shared_ptr<data::mapping::ObjectMapper>& objectMapper,
+                             const oatpp::Object<oas3::Document>& document,
+                             const Resources& resources,
+                             const ControllerPaths& paths,
+                             const ControllerConfig& config)
+  : m_objectMapper(objectMapper)
+  , m_documentCache(std::make_shared<DocumentCache>(objectMapper, document))
+{
+  renderUI(resources, paths, config);
+  if(config.prebuiltResponses) {
+    prebuildResponses(resources, paths);
+  }
+}
+
+void DocumentState::renderUI(const Resources& resources, const ControllerPaths& paths, const ControllerConfig& config) {
+
+  // The UI references the whole document by apiJson. Point it to the content-addressed path instead.
+  ControllerPaths uiPaths = paths;
+  if(config.contentAddressedSpec) {
+    uiPaths.apiJson = UiRenderer::renderVersionPath(paths, m_documentCache->getVersion());
+  }
+
+  std::vector<oatpp::String> tags;
+  if(config.splitByTag) {
+    tags = getTagDocuments()->getTags();
+  }
+
+  auto initializer = UiRenderer::renderInitializer(resources, uiPaths, config, m_documentCache->getData(), tags);
+  m_initializer = ResponseFactory::createContent(initializer, resources.getMimeType("swagger-initializer.js"));
+  auto index = UiRenderer::renderIndex(resources, uiPaths, config, initializer);
+  auto links = UiRenderer::renderPreloadLinks(resources, uiPaths, config, index);
+  if(index || links) {
+    m_uiRoot = ResponseFactory::createContent(index ? index : resources.getResourceData("index.html"),
+                                              resources.getMimeType("index.html"));
+    if(links) {
+      m_uiRoot.headers.push_back({"Link", links});
+    }
+  }
+
+}
+
+void DocumentState::prebuildResponses(const Resources& resources, const ControllerPaths& paths) {
+
+  m_prebuiltResponses.addEndpoint(paths.apiJson, {m_documentCache->getData(), m_documentCache->getETag(), "application/json"});
+  // Prebuilding the response of the index builds the index - responses are assembled ahead of the first request by design.
+  auto index = getOperationIndex();
+  m_prebuiltResponses.addEndpoint(paths.apiIndex, {index->getData(), index->getETag(), "application/json"});
+  m_prebuiltResponses.addEndpoint(paths.initializer, m_initializer);
+  if(m_uiRoot.data) {
+    m_prebuiltResponses.addEndpoint(paths.ui, m_uiRoot);
+  }
+
+  for(auto& filename : resources.getResourceNames()) {
+    auto data = resources.findResource(filename)->getInMemoryData();
+    if(data) {
+      ResponseFactory::Content content {data, resources.getResourceETag(filename), resources.getMimeType(filename)};
+      m_prebuiltResponses.addResource(filename, content);
+      if(filename == "index.html" && !m_uiRoot.data) {
+        m_prebuiltResponses.addEndpoint(paths.ui, content);
+      }
+    }
+  }
+
+}
+
+const std::shared_ptr<DocumentCache>& DocumentState::getDocumentCache() const {
+  return m_documentCache;
+}
+
+std::shared_ptr<TagDocuments> DocumentState::getTagDocuments() {
+  std::call_once(m_tagDocumentsFlag, [this] {
+    m_tagDocuments = std::make_shared<TagDocuments>(m_objectMapper, m_documentCache->getDocument());
+  });
+  return m_tagDocuments;
+}
+
+std::shared_ptr<OperationIndex> DocumentState::getOperationIndex() {
+  std::call_once(m_operationIndexFlag, [this] {
+    m_operationIndex = std::make_shared<OperationIndex>(m_objectMapper, m_documentCache->getDocument());
+  });
+  return m_operationIndex;
+}
+
+std::shared_ptr<SearchIndex> DocumentState::getSearchIndex() {
+  std::call_once(m_searchIndexFlag, [this] {
+    m_searchIndex = std::make_shared<SearchIndex>(m_documentCache->getDocument());
+  });
+  return m_searchIndex;
+}
+
+std::shared_ptr<DocumentFragments> DocumentState::getFragments() {
+  std::call_once(m_fragmentsFlag, [this] {
+    m_fragments = std::make_shared<DocumentFragments>(m_objectMapper, m_documentCache->getDocument());
+  });
+  return m_fragments;
+}
+
+const ResponseFactory::Content& DocumentState::getInitializer() const {
+  return m_initializer;
+}
+
+const ResponseFactory::Content& DocumentState::getUIRoot() const {
+  return m_uiRoot;
+}
+
+const PrebuiltResponses& DocumentState::getPrebuiltResponses() const {
+  return m_prebuiltResponses;
+}
+
+std::shared_ptr<SizeAnalyzer> DocumentState::getSizeAnalyzer() {
+  std::call_once(m_sizeAnalyzerFlag, [this] {
+    m_sizeAnalyzer = std::make_shared<SizeAnalyzer>(m_objectMapper, m_documentCache->getDocument());
+  });
+  return m_sizeAnalyzer;
+}
+
+}}
@@ -0,0 +1,148 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi, <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef oatpp_swagger_DocumentState_hpp
+#define oatpp_swagger_DocumentState_hpp
+
+#include "oatpp-swagger/ControllerConfig.hpp"
+#include "oatpp-swagger/ControllerPaths.hpp"
+#include "oatpp-swagger/DocumentCache.hpp"
+#include "oatpp-swagger/DocumentFragments.hpp"
+#include "oatpp-swagger/OperationIndex.hpp"
+#include "oatpp-swagger/PrebuiltResponses.hpp"
+#include "oatpp-swagger/Resources.hpp"
+#include "oatpp-swagger/SearchIndex.hpp"
+#include "oatpp-swagger/SizeAnalyzer.hpp"
+#include "oatpp-swagger/TagDocuments.hpp"
+
+#include <mutex>
+
+namespace oatpp { namespace swagger {
+
+/**
+ * Everything the swagger controllers serve that is derived from the API document -
+ * serialized document, per-tag documents, indexes, rendered UI pages and prebuilt responses. <br>
+ * Built once per document and never modified afterwards (except for the lazily filled caches which are thread-safe),
+ * so that a new document can be published by replacing one pointer.
+ */
+class DocumentState {
+private:
+  std::shared_ptr<data::mapping::ObjectMapper> m_objectMapper;
+  std::shared_ptr<DocumentCache> m_documentCache;
+  ResponseFactory::Content m_initializer;
+  ResponseFactory::Content m_uiRoot;
+  PrebuiltResponses m_prebuiltResponses;
+private:
+  // Built on first use from the document of m_documentCache. Declared after it, so destroyed before the document.
+  std::once_flag m_tagDocumentsFlag;
+  std::shared_ptr<TagDocuments> m_tagDocuments;
+  std::once_flag m_operationIndexFlag;
+  std::shared_ptr<OperationIndex> m_operationIndex;
+  std::once_flag m_searchIndexFlag;
+  std::shared_ptr<SearchIndex> m_searchIndex;
+  std::once_flag m_fragmentsFlag;
+  std::shared_ptr<DocumentFragments> m_fragments;
+  std::once_flag m_sizeAnalyzerFlag;
+  std::shared_ptr<SizeAnalyzer> m_sizeAnalyzer;
+private:
+  void renderUI(const Resources& resources, const ControllerPaths& paths, const ControllerConfig& config);
+  void prebuildResponses(const Resources& resources, const ControllerPaths& paths);
+public:
+
+  /**
+   * Constructor. Serializes the document, renders UI pages and,
+   * if &id:oatpp::swagger::ControllerConfig::prebuiltResponses; is set, prebuilds responses.
+   * Per-tag documents, indexes and fragments are built on first use.
+   * @param objectMapper - &id:oatpp::data::mapping::ObjectMapper;.
+   * @param document - &id:oatpp::swagger::oas3::Document;.
+   * @param resources - &id:oatpp::swagger::Resources;.
+   * @param paths - &id:oatpp::swagger::ControllerPaths;.
+   * @param config - &id:oatpp::swagger::ControllerConfig;.
+   */
+  DocumentState(const std::shared_ptr<data::mapping::ObjectMapper>& objectMapper,
+                const oatpp::Object<oas3::Document>& document,
+                const Resources& resources,
+                const ControllerPaths& paths,
+                const ControllerConfig& config);
+
+  /**
+   * Get serialized document.
+   * @return - &id:oatpp::swagger::DocumentCache;.
+   */
+  const std::shared_ptr<DocumentCache>& getDocumentCache() const;
+
+  /**
+   * Get per-tag documents. The documents are split on the first call.
+   * @return - &id:oatpp::swagger::TagDocuments;.
+   */
+  std::shared_ptr<TagDocuments> getTagDocuments();
+
+  /**
+   * Get operation index. The index is built on the first call.
+   * @return - &id:oatpp::swagger::OperationIndex;.
+   */
+  std::shared_ptr<OperationIndex> getOperationIndex();
+
+  /**
+   * Get search index. The index is built on the first call.
+   * @return - &id:oatpp::swagger::SearchIndex;.
+   */
+  std::shared_ptr<SearchIndex> getSearchIndex();
+
+  /**
+   * Get document fragments. Fragments are indexed on the first call.
+   * @return - &id:oatpp::swagger::DocumentFragments;.
+   */
+  std::shared_ptr<DocumentFragments> getFragments();
+
+  /**
+   * Get rendered `swagger-initializer.js`.
+   * @return - &id:oatpp::swagger::ResponseFactory::Content;.
+   */
+  const ResponseFactory::Content& getInitializer() const;
+
+  /**
+   * Get rendered `index.html`.
+   * @return - &id:oatpp::swagger::ResponseFactory::Content;. `data` is `nullptr` if `index.html` is served as is.
+   */
+  const ResponseFactory::Content& getUIRoot() const;
+
+  /**
+   * Get prebuilt responses.
+   * @return - &id:oatpp::swagger::PrebuiltResponses;. Empty if &id:oatpp::swagger::ControllerConfig::prebuiltResponses; is not set.
+   */
+  const PrebuiltResponses& getPrebuiltResponses() const;
+
+  /**
+   * Get size analysis of the document. The analysis runs on the first call.
+   * @return - &id:oatpp::swagger::SizeAnalyzer;.
+   */
+  std::shared_ptr<SizeAnalyzer> getSizeAnalyzer();
+
+};
+
+}}
+
+#endif // oatpp_swagger_DocumentState_hpp
@@ -24,14 +24,46 @@
 
 #include "Generator.hpp"
 
+#include "Deduplicator.hpp"
+
 #include "oatpp/utils/Conversion.hpp"
 #include "oatpp/data/stream/BufferStream.hpp"
 #include "oatpp/base/Log.hpp"
 
+#include <algorithm>
+#include <cstring>
 #include <limits>
 
 namespace oatpp { namespace swagger {
 
+oatpp::String Generator::intern(const char* data, v_buff_size size) {
+
+  std::string_view key(data, static_cast<size_t>(size));
+
+  auto it = m_strings.find(key);
+  if(it != m_strings.end()) {
+    m_stats.stringCacheHits ++;
+    return it->second;
+  }
+
+  oatpp::String result(data, size);
+  m_strings.insert({std::string_view(result->data(), result->size()), result});
+  m_stats.stringsAllocated ++;
+  return result;
+
+}
+
+oatpp::String Generator::intern(const char* str) {
+  if(str == nullptr) {
+    return nullptr;
+  }
+  return intern(str, static_cast<v_buff_size>(std::strlen(str)));
+}
+
+oatpp::String Generator::intern(const std::string& str) {
+  return intern(str.data(), static_cast<v_buff_size>(str.size()));
+}
+
 oatpp::String Generator::getEnumSchemaName(const Type* type) {
 
   auto polymorphicDispatcher = static_cast<const data::type::__class::AbstractEnum::PolymorphicDispatcher*>(
@@ -42,61 +74,116 @@ oatpp::String Generator::getEnumSchemaName(const Type* type) {
 
   data::stream::BufferOutputStream stream;
   stream << type->nameQualifier << "_" << interType->classId.name;
-  return stream.toString();
+  return intern(*stream.toString());
 
 }
 
+oatpp::String Generator::getSchemaName(const Type* type) {
+
+  auto it = m_schemaNames.find(type);
+  if(it != m_schemaNames.end()) {
+    return it->second;
+  }
+
+  oatpp::String name;
+  if(type->classId.id == oatpp::data::type::__class::AbstractEnum::CLASS_ID.id) {
+    name = getEnumSchemaName(type);
+  } else {
+    name = intern(type->nameQualifier);
+  }
+
+  m_schemaNames[type] = name;
+  return name;
+
+}
+
+oatpp::String Generator::getSchemaRef(const Type* type) {
+
+  auto it = m_schemaRefs.find(type);
+  if(it != m_schemaRefs.end()) {
+    return it->second;
+  }
+
+  auto ref = intern(*(oatpp::String("#/components/schemas/") + getSchemaName(type)));
+  m_schemaRefs[type] = ref;
+  return ref;
+
+}
+
+oatpp::Object<oas3::Schema> Generator::createSimpleSchema(const oatpp::String& type,
+                                                         const oatpp::String& format,
+                                                         const oatpp::Int64& minimum,
+                                                         const oatpp::Int64& maximum)
+{
+  auto result = oas3::Schema::createShared();
+  result->type = type;
+  result->format = format;
+  result->minimum = minimum;
+  result->maximum = maximum;
+  m_sharedSchemas.insert(result.get());
+  return result;
+}
+
+void Generator::initSimpleSchemas() {
+
+  m_simpleSchemas[oatpp::data::type::__class::String::CLASS_ID.id] = createSimpleSchema("string", nullptr, nullptr, nullptr);
+
+  m_simpleSchemas[oatpp::data::type::__class::Int8::CLASS_ID.id] =
+    createSimpleSchema("integer", nullptr, std::numeric_limits<v_int8>::min(), std::numeric_limits<v_int8>::max());
+  m_simpleSchemas[oatpp::data::type::__class::UInt8::CLASS_ID.id] =
+    createSimpleSchema("integer", nullptr, std::numeric_limits<v_uint8>::min(), std::numeric_limits<v_uint8>::max());
+  m_simpleSchemas[oatpp::data::type::__class::Int16::CLASS_ID.id] =
+    createSimpleSchema("integer", nullptr, std::numeric_limits<v_int16>::min(), std::numeric_limits<v_int16>::max());
+  m_simpleSchemas[oatpp::data::type::__class::UInt16::CLASS_ID.id] =
+    createSimpleSchema("integer", nullptr, std::numeric_limits<v_uint16>::min(), std::numeric_limits<v_uint16>::max());
+  if(m_config->compact) {
+    // The range is implied by the format.
+    m_simpleSchemas[oatpp::data::type::__class::Int32::CLASS_ID.id] = createSimpleSchema("integer", "int32", nullptr, nullptr);
+  } else {
+    m_simpleSchemas[oatpp::data::type::__class::Int32::CLASS_ID.id] =
+      createSimpleSchema("integer", nullptr, std::numeric_limits<v_int32>::min(), std::numeric_limits<v_int32>::max());
+  }
+  m_simpleSchemas[oatpp::data::type::__class::UInt32::CLASS_ID.id] =
+    createSimpleSchema("integer", nullptr, std::numeric_limits<v_uint32>::min(), std::numeric_limits<v_uint32>::max());
+
+  m_simpleSchemas[oatpp::data::type::__class::Int64::CLASS_ID.id] = createSimpleSchema("integer", "int64", nullptr, nullptr);
+  m_simpleSchemas[oatpp::data::type::__class::UInt64::CLASS_ID.id] = createSimpleSchema("integer", nullptr, nullptr, nullptr);
+  m_simpleSchemas[oatpp::data::type::__class::Float32::CLASS_ID.id] = createSimpleSchema("number", "float", nullptr, nullptr);
+  m_simpleSchemas[oatpp::data::type::__class::Float64::CLASS_ID.id] = createSimpleSchema("number", "double", nullptr, nullptr);
+  m_simpleSchemas[oatpp::data::type::__class::Boolean::CLASS_ID.id] = createSimpleSchema("boolean", nullptr, nullptr, nullptr);
+
+}
+
+oatpp::Object<oas3::Schema> Generator::createSchema() {
+  m_stats.schemasGenerated ++;
+  return allocate<oatpp::Object<oas3::Schema>>();
+}
+
+oatpp::Object<oas3::Schema> Generator::getMutableSchema(const oatpp::Object<oas3::Schema>& schema) {
+  if(m_sharedSchemas.find(schema.get()) != m_sharedSchemas.end()) {
+    m_stats.schemaCacheHits --;
+    return oas3::Schema::createShallowCopy(schema, createSchema());
+  }
+  return schema;
+}
+
 oatpp::Object<oas3::Schema> Generator::generateSchemaForSimpleType(const Type* type, oatpp::BaseObject::Property* property, const oatpp::Void& defaultValue) {
 
   OATPP_ASSERT(type && "[oatpp-swagger::oas3::Generator::generateSchemaForSimpleType()]: Error. Type should not be null.");
 
-  auto result = oas3::Schema::createShared();
+  auto it = m_simpleSchemas.find(type->classId.id);
+  if(it == m_simpleSchemas.end()) {
+    return nullptr; // Unknown simple type;
+  }
 
-  auto classId = type->classId.id;
-  if(classId == oatpp::data::type::__class::String::CLASS_ID.id) {
-    result->type = "string";
+  auto result = it->second;
+  m_stats.schemaCacheHits ++;
+
+  if(type->classId.id == oatpp::data::type::__class::String::CLASS_ID.id) {
     if(property != nullptr && !property->info.pattern.empty()) {
-      result->pattern = property->info.pattern.c_str();
+      result = getMutableSchema(result);
+      result->pattern = intern(property->info.pattern);
     }
-  } else if(classId == oatpp::data::type::__class::Int8::CLASS_ID.id) {
-    result->type = "integer";
-    result->minimum = std::numeric_limits<v_int8>::min();
-    result->maximum = std::numeric_limits<v_int8>::max();
-  } else if(classId == oatpp::data::type::__class::UInt8::CLASS_ID.id) {
-    result->type = "integer";
-    result->minimum = std::numeric_limits<v_uint8>::min();
-    result->maximum = std::numeric_limits<v_uint8>::max();
-  } else if(classId == oatpp::data::type::__class::Int16::CLASS_ID.id) {
-    result->type = "integer";
-    result->minimum = std::numeric_limits<v_int16>::min();
-    result->maximum = std::numeric_limits<v_int16>::max();
-  } else if(classId == oatpp::data::type::__class::UInt16::CLASS_ID.id) {
-    result->type = "integer";
-    result->minimum = std::numeric_limits<v_uint16>::min();
-    result->maximum = std::numeric_limits<v_uint16>::max();
-  } else if(classId == oatpp::data::type::__class::Int32::CLASS_ID.id) {
-    result->type = "integer";
-    result->minimum = std::numeric_limits<v_int32>::min();
-    result->maximum = std::numeric_limits<v_int32>::max();
-  } else if(classId == oatpp::data::type::__class::UInt32::CLASS_ID.id) {
-    result->type = "integer";
-    result->minimum = std::numeric_limits<v_uint32>::min();
-    result->maximum = std::numeric_limits<v_uint32>::max();
-  } else if(classId == oatpp::data::type::__class::Int64::CLASS_ID.id) {
-    result->type = "integer";
-    result->format = "int64";
-  } else if(classId == oatpp::data::type::__class::UInt64::CLASS_ID.id) {
-    result->type = "integer";
-  } else if(classId == oatpp::data::type::__class::Float32::CLASS_ID.id) {
-    result->type = "number";
-    result->format = "float";
-  } else if(classId == oatpp::data::type::__class::Float64::CLASS_ID.id) {
-    result->type = "number";
-    result->format = "double";
-  } else if(classId == oatpp::data::type::__class::Boolean::CLASS_ID.id) {
-    result->type = "boolean";
-  } else {
-    return nullptr; // Unknown simple type;
   }
 
   return result;
@@ -107,17 +194,17 @@ oatpp::Object<oas3::Schema> Generator::generateSchemaForTypeObject(const Type* t
 
   OATPP_ASSERT(type && "[oatpp-swagger::oas3::Generator::generateSchemaForTypeObject()]: Error. Type should not be null.");
 
-  auto result = oas3::Schema::createShared();
+  auto result = createSchema();
   if(linkSchema) {
 
-    result->ref = oatpp::String("#/components/schemas/") + type->nameQualifier;
-    usedTypes[type->nameQualifier] = type;
+    result->ref = getSchemaRef(type);
+    usedTypes.insert(type);
     return result;
 
   } else {
 
-    result->type = "object";
-    result->properties = {};
+    result->type = intern("object");
+    result->properties = allocate<oatpp::Fields<oatpp::Object<oas3::Schema>>>();
 
     auto polymorphicDispatcher = static_cast<const oatpp::data::type::__class::AbstractObject::PolymorphicDispatcher*>(
       type->polymorphicDispatcher
@@ -127,16 +214,23 @@ oatpp::Object<oas3::Schema> Generator::generateSchemaForTypeObject(const Type* t
 
     for(auto* p : properties->getList()) {
       const auto& defaultValue = p->get(static_cast<oatpp::BaseObject*>(instance.get()));
-      result->properties[p->name] = generateSchemaForType(p->type, true, usedTypes, p, defaultValue);
+      // property names are unique within the object - no need to look the key up
+      result->properties->push_back({intern(p->name), generateSchemaForType(p->type, true, usedTypes, p, defaultValue)});
     }
 
-    result->required = oatpp::List<oatpp::String>::createShared();
     for (auto* p : properties->getList()) {
       if (p->info.required) {
-        result->required->push_back(p->name);
+        if(!result->required) {
+          result->required = allocate<oatpp::List<oatpp::String>>();
+        }
+        result->required->push_back(intern(p->name));
       }
     }
 
+    if(!result->required && !m_config->compact) {
+      result->required = allocate<oatpp::List<oatpp::String>>();
+    }
+
     return result;
   }
 
@@ -144,8 +238,8 @@ oatpp::Object<oas3::Schema> Generator::generateSchemaForTypeObject(const Type* t
 
 oatpp::Object<oas3::Schema> Generator::generateSchemaForCollection_1D(const Type* type, bool linkSchema, UsedTypes& usedTypes, bool uniqueItems) {
   OATPP_ASSERT(type && "[oatpp-swagger::oas3::Generator::generateSchemaForCollection_1D()]: Error. Type should not be null.");
-  auto result = oas3::Schema::createShared();
-  result->type = "array";
+  auto result = createSchema();
+  result->type = intern("array");
   result->items = generateSchemaForType(*type->params.begin(), linkSchema, usedTypes);
   if(uniqueItems) {
     result->uniqueItems = true;
@@ -158,9 +252,9 @@ oatpp::Object<oas3::Schema> Generator::generateSchemaForEnum(const Type* type, b
 
   if(linkSchema) {
 
-    auto result = oas3::Schema::createShared();
-    result->ref = oatpp::String("#/components/schemas/") + getEnumSchemaName(type);
-    usedTypes[getEnumSchemaName(type)] = type;
+    auto result = createSchema();
+    result->ref = getSchemaRef(type);
+    usedTypes.insert(type);
     return result;
 
   }
@@ -170,9 +264,9 @@ oatpp::Object<oas3::Schema> Generator::generateSchemaForEnum(const Type* type, b
   );
 
   Type* interType = polymorphicDispatcher->getInterpretationType();
-  auto result = generateSchemaForType(interType, linkSchema, usedTypes);
+  auto result = getMutableSchema(generateSchemaForType(interType, linkSchema, usedTypes));
 
-  result->enumValues = oatpp::List<oatpp::Any>::createShared();
+  result->enumValues = allocate<oatpp::List<oatpp::Any>>();
   auto interEnum = polymorphicDispatcher->getInterpretedEnum(false);
   for(auto& v : interEnum) {
     result->enumValues->push_back(v);
@@ -185,11 +279,11 @@ oatpp::Object<oas3::Schema> Generator::generateSchemaForEnum(const Type* type, b
 oatpp::Object<oas3::Schema> Generator::generateSchemaForAbstractPairList(const Type* type, bool linkSchema, UsedTypes& usedTypes, oatpp::BaseObject::Property* property ) {
   OATPP_ASSERT(type && "[oatpp-swagger::oas3::Generator::generateSchemaForAbstractPairList()]: Error. Type should not be null.");
 
-  auto result = oas3::Schema::createShared();
+  auto result = createSchema();
 
   // A PairList<String, T> is a Fields<T> and a Fields<T> is a simple JSON object
   if (type->params.front()->classId.id == oatpp::String::Class::CLASS_ID.id) {
-    result->type = "object";
+    result->type = intern("object");
     result->additionalProperties = generateSchemaForType(type->params.back(), linkSchema, usedTypes);
   }
 
@@ -228,18 +322,22 @@ oatpp::Object<oas3::Schema> Generator::generateSchemaForType(const Type* type, b
   }
 
   if(!result) {
-    result = oas3::Schema::createShared();
-    result->type = type->classId.name;
+    result = createSchema();
+    result->type = intern(type->classId.name);
     if(type->nameQualifier) {
-      result->format = type->nameQualifier;
+      result->format = intern(type->nameQualifier);
     }
   }
 
-  if(property != nullptr) {
+  // Siblings of $ref are ignored - in compact mode don't repeat the default value of the referenced type.
+  bool addDefault = defaultValue && !(m_config->compact && result->ref);
+
+  if(property != nullptr && (!property->info.description.empty() || addDefault)) {
+    result = getMutableSchema(result);
     if(!property->info.description.empty()) {
-      result->description = property->info.description.c_str();
+      result->description = intern(property->info.description);
     }
-    if (defaultValue) {
+    if (addDefault) {
       result->defaultValue = defaultValue;
     }
   }
@@ -255,12 +353,17 @@ void Generator::addParamsToParametersList(const PathItemParameters& paramsList,
 
   for(auto& paramName : params.getOrder()) {
     auto param = params[paramName];
-    auto parameter = oas3::PathItemParameter::createShared();
+    auto parameter = allocate<oatpp::Object<oas3::PathItemParameter>>();
     parameter->in = inType;
     parameter->name = param.name;
     parameter->description = param.description;
-    parameter->required = param.required;
-    parameter->deprecated = param.deprecated;
+    // `false` is the default for both.
+    if(!m_config->compact || param.required) {
+      parameter->required = param.required;
+    }
+    if(!m_config->compact || param.deprecated) {
+      parameter->deprecated = param.deprecated;
+    }
     parameter->schema = generateSchemaForType(param.type, true, usedTypes);
 
     for(auto& ex : param.examples) {
@@ -276,13 +379,15 @@ oatpp::Object<oas3::RequestBody> Generator::generateRequestBody(const Endpoint::
 
   if(endpointInfo.consumes.size() > 0) {
 
-    auto body = oas3::RequestBody::createShared();
+    auto body = allocate<oatpp::Object<oas3::RequestBody>>();
     body->description = endpointInfo.body.description;
-    body->required = endpointInfo.body.required;
-    body->content = body->content.createShared();
+    if(!m_config->compact || endpointInfo.body.required) {
+      body->required = endpointInfo.body.required;
+    }
+    body->content = allocate<oatpp::Fields<oatpp::Object<oas3::MediaTypeObject>>>();
 
     for(auto& hint : endpointInfo.consumes) {
-      auto mediaType = oas3::MediaTypeObject::createShared();
+      auto mediaType = allocate<oatpp::Object<oas3::MediaTypeObject>>();
 
       mediaType->schema = generateSchemaForType(hint.schema, linkSchema, usedTypes);
 
@@ -305,17 +410,19 @@ oatpp::Object<oas3::RequestBody> Generator::generateRequestBody(const Endpoint::
 
     if(endpointInfo.body.name != nullptr && endpointInfo.body.type != nullptr) {
 
-      auto body = oas3::RequestBody::createShared();
+      auto body = allocate<oatpp::Object<oas3::RequestBody>>();
       body->description = endpointInfo.body.description;
-      body->required = endpointInfo.body.required;
+      if(!m_config->compact || endpointInfo.body.required) {
+        body->required = endpointInfo.body.required;
+      }
 
-      auto mediaType = oas3::MediaTypeObject::createShared();
+      auto mediaType = allocate<oatpp::Object<oas3::MediaTypeObject>>();
       mediaType->schema = generateSchemaForType(endpointInfo.body.type, linkSchema, usedTypes);
       for(auto& ex : endpointInfo.body.examples) {
         mediaType->addExample(ex.first, ex.second);
       }
 
-      body->content = body->content.createShared();
+      body->content = allocate<oatpp::Fields<oatpp::Object<oas3::MediaTypeObject>>>();
 
       if(endpointInfo.bodyContentType != nullptr) {
         body->content[endpointInfo.bodyContentType] = mediaType;
@@ -335,24 +442,24 @@ oatpp::Object<oas3::RequestBody> Generator::generateRequestBody(const Endpoint::
 
 oatpp::Fields<Object<oas3::OperationResponse>> Generator::generateResponses(const Endpoint::Info& endpointInfo, bool linkSchema, UsedTypes& usedTypes) {
 
-  auto responses = Fields<Object<oas3::OperationResponse>>::createShared();
+  auto responses = allocate<oatpp::Fields<oatpp::Object<oas3::OperationResponse>>>();
 
   if(endpointInfo.responses.size() > 0) {
 
     for(auto& hint : endpointInfo.responses) {
 
-      auto response = oas3::OperationResponse::createShared();
+      auto response = allocate<oatpp::Object<oas3::OperationResponse>>();
 
       if(hint.second.schema != nullptr) {
 
-        auto mediaType = oas3::MediaTypeObject::createShared();
+        auto mediaType = allocate<oatpp::Object<oas3::MediaTypeObject>>();
         mediaType->schema = generateSchemaForType(hint.second.schema, linkSchema, usedTypes);
 
         for(auto& ex : hint.second.examples) {
           mediaType->addExample(ex.first, ex.second);
         }
 
-        response->content = {};
+        response->content = allocate<oatpp::Fields<oatpp::Object<oas3::MediaTypeObject>>>();
         response->content[hint.second.contentType] = mediaType;
 
       }
@@ -364,7 +471,8 @@ oatpp::Fields<Object<oas3::OperationResponse>> Generator::generateResponses(cons
 
   } else {
 
-    auto response = oas3::OperationResponse::createShared();
+    // Kept in compact mode as well - `responses` must not be empty and `description` is required.
+    auto response = allocate<oatpp::Object<oas3::OperationResponse>>();
     response->description = "success";
     responses["200"] = response;
 
@@ -380,13 +488,13 @@ void Generator::generatePathItemData(const std::shared_ptr<Endpoint>& endpoint,
 
   if(info) {
 
-    auto operation = oas3::PathItemOperation::createShared();
+    auto operation = allocate<oatpp::Object<oas3::PathItemOperation>>();
     operation->operationId = info->name;
     operation->summary = info->summary;
     operation->description = info->description;
 
     if(info->tags.size() > 0) {
-      operation->tags = oatpp::List<String>({});
+      operation->tags = allocate<oatpp::List<oatpp::String>>();
       for(auto& tag : info->tags) {
         operation->tags->push_back(tag);
       }
@@ -415,7 +523,7 @@ void Generator::generatePathItemData(const std::shared_ptr<Endpoint>& endpoint,
 
     if(!operation->parameters) {
 
-      operation->parameters = {};
+      operation->parameters = allocate<PathItemParameters>();
 
       Endpoint::Info::Params filteredHeaders;
       if(!info->headers.getOrder().empty()) {
@@ -431,6 +539,10 @@ void Generator::generatePathItemData(const std::shared_ptr<Endpoint>& endpoint,
       addParamsToParametersList(operation->parameters, info->pathParams, "path", usedTypes);
       addParamsToParametersList(operation->parameters, info->queryParams, "query", usedTypes);
 
+      if(m_config->compact && operation->parameters->empty()) {
+        operation->parameters = nullptr;
+      }
+
     }
 
     if(!info->securityRequirements.empty()) {
@@ -444,7 +556,18 @@ void Generator::generatePathItemData(const std::shared_ptr<Endpoint>& endpoint,
 
         operation->security = oatpp::List<Fields<List<String>>>({});
 
+        // Security requirements are stored in a hash map - sort them by name for a stable output.
+        std::vector<const decltype(info->securityRequirements)::value_type*> requirements;
         for (const auto &sec : info->securityRequirements) {
+          requirements.push_back(&sec);
+        }
+        std::sort(requirements.begin(), requirements.end(), [](const auto* a, const auto* b) {
+          return *a->first < *b->first;
+        });
+
+        for (const auto* requirement : requirements) {
+
+          const auto &sec = *requirement;
 
           usedSecuritySchemes[sec.first] = true;
           if (sec.second == nullptr) {
@@ -473,7 +596,7 @@ void Generator::generatePathItemData(const std::shared_ptr<Endpoint>& endpoint,
 
 Generator::Paths Generator::generatePaths(const Endpoints& endpoints, UsedTypes& usedTypes, UsedSecuritySchemes &usedSecuritySchemes) {
 
-  auto result = Paths::createShared();
+  auto result = allocate<Paths>();
 
   for(auto& endpoint : endpoints.list) {
     if(endpoint->info() && !endpoint->info()->hide) {
@@ -481,13 +604,14 @@ Generator::Paths Generator::generatePaths(const Endpoints& endpoints, UsedTypes&
       if(path->size() == 0) {
         continue;
       }
+      m_stats.endpointsCount ++;
       if(path->data()[0] != '/') {
         path = "/" + path;
       }
 
       auto& pathItem = result[path];
       if(!pathItem) {
-        pathItem = oas3::PathItem::createShared();
+        pathItem = allocate<oatpp::Object<oas3::PathItem>>();
       }
 
       generatePathItemData(endpoint, pathItem, usedTypes, usedSecuritySchemes);
@@ -498,107 +622,108 @@ Generator::Paths Generator::generatePaths(const Endpoints& endpoints, UsedTypes&
 
 }
 
-void Generator::decomposeObject(const Type* type, UsedTypes& decomposedTypes) {
+Generator::DecomposedTypes Generator::decomposeTypes(const UsedTypes& usedTypes) {
 
-  OATPP_ASSERT(type && "[oatpp-swagger::oas3::Generator::decomposeObject()]: Error. Type should not be null.");
+  DecomposedTypes result; // types which go to components/schemas
 
-  auto schemaIt = decomposedTypes.find(type->nameQualifier);
-  if(schemaIt != decomposedTypes.end()) {
-    return;
-  }
+  // The document must not depend on the iteration order of the hash sets or on type addresses.
+  // Types are walked starting from the smallest schema name, and the result is ordered by the schema name.
+  // Ties between types of the same name are kept in the order they were referenced from the endpoints.
+  auto byName = [this](const Type* a, const Type* b) {
+    return *getSchemaName(a) < *getSchemaName(b);
+  };
 
-  decomposedTypes[type->nameQualifier] = type;
+  std::unordered_set<const Type*> visitedTypes;
+  std::vector<const Type*> worklist(usedTypes.getOrder());
+  std::stable_sort(worklist.begin(), worklist.end(), byName);
+  std::reverse(worklist.begin(), worklist.end());
 
-  auto polymorphicDispatcher = static_cast<const oatpp::data::type::__class::AbstractObject::PolymorphicDispatcher*>(
-    type->polymorphicDispatcher
-  );
-  auto properties = polymorphicDispatcher->getProperties();
+  while(!worklist.empty()) {
 
-  for(auto* p : properties->getList()) {
-    decomposeType(p->type, decomposedTypes);
-  }
+    const Type* type = worklist.back();
+    worklist.pop_back();
 
-}
+    OATPP_ASSERT(type && "[oatpp-swagger::oas3::Generator::decomposeTypes()]: Error. Type should not be null.");
 
-void Generator::decomposeCollection_1D(const Type* type, UsedTypes& decomposedTypes) {
-  OATPP_ASSERT(type && "[oatpp-swagger::oas3::Generator::Collection_1D()]: Error. Type should not be null.");
-  decomposeType(*type->params.begin(), decomposedTypes);
-}
+    if(!visitedTypes.insert(type).second) {
+      continue;
+    }
 
-void Generator::decomposeMap(const Type* type, UsedTypes& decomposedTypes) {
-  OATPP_ASSERT(type && "[oatpp-swagger::oas3::Generator::decomposeMap()]: Error. Type should not be null.");
+    auto classId = type->classId.id;
 
-  // The only possible JSON representation of a PairList<A, B> is A being a String, even if an numeric one
-  if (type->params.front()->classId.id == oatpp::data::type::__class::String::CLASS_ID.id) {
-    decomposeType(type->params.back(), decomposedTypes);
-  }
+    if(classId == oatpp::data::type::__class::AbstractObject::CLASS_ID.id) {
 
-  // TODO - more advanced cases with complex key types
-}
+      result.push_back(type);
 
-void Generator::decomposeEnum(const Type* type, UsedTypes& decomposedTypes) {
-  auto schemaIt = decomposedTypes.find(getEnumSchemaName(type));
-  if(schemaIt != decomposedTypes.end()) {
-    return;
-  }
-  decomposedTypes[getEnumSchemaName(type)] = type;
-}
+      auto polymorphicDispatcher = static_cast<const oatpp::data::type::__class::AbstractObject::PolymorphicDispatcher*>(
+        type->polymorphicDispatcher
+      );
+      const auto& properties = polymorphicDispatcher->getProperties()->getList();
+      for(auto it = properties.rbegin(); it != properties.rend(); ++it) {
+        worklist.push_back((*it)->type);
+      }
+
+    } else if(classId == oatpp::data::type::__class::AbstractVector::CLASS_ID.id ||
+              classId == oatpp::data::type::__class::AbstractList::CLASS_ID.id ||
+              classId == oatpp::data::type::__class::AbstractUnorderedSet::CLASS_ID.id)
+    {
+      worklist.push_back(*type->params.begin());
+    } else if(classId == oatpp::data::type::__class::AbstractPairList::CLASS_ID.id) {
+      // The only possible JSON representation of a PairList<A, B> is A being a String, even if an numeric one
+      if (type->params.front()->classId.id == oatpp::data::type::__class::String::CLASS_ID.id) {
+        worklist.push_back(type->params.back());
+      }
+      // TODO - more advanced cases with complex key types
+    } else if(classId == oatpp::data::type::__class::AbstractEnum::CLASS_ID.id) {
+      result.push_back(type);
+    }
 
-void Generator::decomposeType(const Type* type, UsedTypes& decomposedTypes) {
-  OATPP_ASSERT(type && "[oatpp-swagger::oas3::Generator::decomposeType()]: Error. Type should not be null.");
-  auto classId = type->classId.id;
-  if(classId == oatpp::data::type::__class::AbstractObject::CLASS_ID.id){
-    decomposeObject(type, decomposedTypes);
-  } else if(classId == oatpp::data::type::__class::AbstractVector::CLASS_ID.id){
-    decomposeCollection_1D(type, decomposedTypes);
-  } else if(classId == oatpp::data::type::__class::AbstractList::CLASS_ID.id){
-    decomposeCollection_1D(type, decomposedTypes);
-  } else if(classId == oatpp::data::type::__class::AbstractUnorderedSet::CLASS_ID.id){
-    decomposeCollection_1D(type, decomposedTypes);
-  } else if(classId == oatpp::data::type::__class::AbstractPairList::CLASS_ID.id){
-    decomposeMap(type, decomposedTypes);
-  } else if(classId == oatpp::data::type::__class::AbstractEnum::CLASS_ID.id){
-    decomposeEnum(type, decomposedTypes);
-  }
-}
-  
-Generator::UsedTypes Generator::decomposeTypes(UsedTypes& usedTypes) {
-  
-  UsedTypes result; // decomposed schemas
-  
-  auto it = usedTypes.begin();
-  while (it != usedTypes.end()) {
-    decomposeType(it->second, result);
-    result[it->first] = it->second;
-    it ++;
   }
-  
+
+  std::stable_sort(result.begin(), result.end(), byName);
+
   return result;
-  
+
 }
 
-oatpp::Object<oas3::Components> Generator::generateComponents(const UsedTypes &decomposedTypes,
+oatpp::Object<oas3::Components> Generator::generateComponents(const DecomposedTypes &decomposedTypes,
                                                               const std::shared_ptr<std::unordered_map<oatpp::String,std::shared_ptr<oatpp::swagger::SecurityScheme>>> &securitySchemes,
                                                               UsedSecuritySchemes &usedSecuritySchemes) {
   
-  auto result = oas3::Components::createShared();
-  result->schemas = {};
+  auto result = allocate<oatpp::Object<oas3::Components>>();
+  result->schemas = allocate<oatpp::Fields<oatpp::Object<oas3::Schema>>>();
   
-  auto it = decomposedTypes.begin();
-  while (it != decomposedTypes.end()) {
-    UsedTypes schemas; ///< dummy
-    result->schemas[it->first] = generateSchemaForType(it->second, false, schemas);
-    it ++;
+  std::unordered_set<oatpp::String> names;
+  for(const Type* type : decomposedTypes) {
+    auto name = getSchemaName(type);
+    // Different types may share the same name. The first one wins.
+    if(names.insert(name).second) {
+      UsedTypes schemas; ///< dummy
+      result->schemas->push_back({name, generateSchemaForType(type, false, schemas)});
+    }
   }
 
+  m_stats.componentSchemasCount = static_cast<v_int64>(result->schemas->size());
+
+  auto securityStart = std::chrono::steady_clock::now();
+
   if(securitySchemes) {
     result->securitySchemes = {};
+    std::vector<oatpp::String> schemeNames;
     for (const auto &ss : usedSecuritySchemes) {
-        OATPP_ASSERT(securitySchemes->find(ss.first) != securitySchemes->end() && "[oatpp-swagger::oas3::Generator::generateComponents()]: Error. Requested unknown security requirement.");
-        result->securitySchemes[ss.first] = generateSecurityScheme(securitySchemes->at(ss.first));
+      schemeNames.push_back(ss.first);
+    }
+    std::sort(schemeNames.begin(), schemeNames.end(), [](const oatpp::String& a, const oatpp::String& b) {
+      return *a < *b;
+    });
+    for (const auto &name : schemeNames) {
+        OATPP_ASSERT(securitySchemes->find(name) != securitySchemes->end() && "[oatpp-swagger::oas3::Generator::generateComponents()]: Error. Requested unknown security requirement.");
+        result->securitySchemes[name] = generateSecurityScheme(securitySchemes->at(name));
     }
   }
 
+  m_stats.securitySchemesMicros = getMicrosSince(securityStart);
+
   return result;
   
 }
@@ -669,13 +794,26 @@ oatpp::Object<oas3::SecurityScheme> Generator::generateSecurityScheme(const std:
   return oasSS;
 }
 
+v_int64 Generator::getMicrosSince(const std::chrono::steady_clock::time_point& start) {
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
 Generator::Generator(const std::shared_ptr<Config>& config)
   : m_config(config)
-{}
+{
+  initSimpleSchemas();
+}
 
 oatpp::Object<oas3::Document> Generator::generateDocument(const std::shared_ptr<oatpp::swagger::DocumentInfo>& docInfo, const Endpoints& endpoints) {
   
-  auto document = oas3::Document::createShared();
+  m_stats = Stats();
+  auto start = std::chrono::steady_clock::now();
+
+  if(m_config->useArena) {
+    m_arena = std::make_shared<Arena>(m_config->arenaChunkSize);
+  }
+
+  auto document = allocate<oatpp::Object<oas3::Document>>();
   document->info = oas3::Info::createFromBaseModel(docInfo->header);
   
   if(docInfo->servers) {
@@ -689,12 +827,54 @@ oatpp::Object<oas3::Document> Generator::generateDocument(const std::shared_ptr<
   
   UsedTypes usedTypes;
   UsedSecuritySchemes usedSecuritySchemes;
+
+  auto phaseStart = std::chrono::steady_clock::now();
   document->paths = generatePaths(endpoints, usedTypes, usedSecuritySchemes);
+  m_stats.pathsMicros = getMicrosSince(phaseStart);
+
+  phaseStart = std::chrono::steady_clock::now();
   auto decomposedTypes = decomposeTypes(usedTypes);
+  m_stats.decompositionMicros = getMicrosSince(phaseStart);
+
+  phaseStart = std::chrono::steady_clock::now();
   document->components = generateComponents(decomposedTypes, docInfo->securitySchemes, usedSecuritySchemes);
+  m_stats.componentsMicros = getMicrosSince(phaseStart) - m_stats.securitySchemesMicros;
+
+  if(m_config->deduplicateSchemas) {
+    phaseStart = std::chrono::steady_clock::now();
+    Deduplicator deduplicator(m_config->hoistDuplicateSchemas, m_sharedSchemas);
+    deduplicator.deduplicate(document);
+    m_stats.deduplicationMicros = getMicrosSince(phaseStart);
+  }
+
+  if(m_arena) {
+    m_stats.arenaSize = m_arena->getUsedSize();
+  }
+
+  m_stats.totalMicros = getMicrosSince(start);
+
+  // Arena is kept alive by the allocated nodes and is released together with the last of them.
+  m_arena.reset();
+
+  m_strings.clear();
+  m_schemaNames.clear();
+  m_schemaRefs.clear();
 
   return document;
   
 }
 
+const Generator::Stats& Generator::getStats() const {
+  return m_stats;
+}
+
+void Generator::logStats(const char* tag, const Stats& stats) {
+  OATPP_LOGd(tag, "Document generated in {}us: paths={}us, decomposition={}us, components={}us, securitySchemes={}us, deduplication={}us",
+             stats.totalMicros, stats.pathsMicros, stats.decompositionMicros, stats.componentsMicros,
+             stats.securitySchemesMicros, stats.deduplicationMicros);
+  OATPP_LOGd(tag, "endpoints={}, schemas generated={}, schema cache hits={}, component schemas={}, strings allocated={}, string cache hits={}, arena={} bytes, serialized size={} bytes",
+             stats.endpointsCount, stats.schemasGenerated, stats.schemaCacheHits, stats.componentSchemasCount,
+             stats.stringsAllocated, stats.stringCacheHits, stats.arenaSize, stats.serializedSize);
+}
+
 }}
@@ -26,11 +26,16 @@
 #define oatpp_swagger_Generator_hpp
 
 #include "oatpp-swagger/oas3/Model.hpp"
+#include "oatpp-swagger/Arena.hpp"
 
 #include "oatpp/web/server/api/Endpoint.hpp"
 
+#include <chrono>
 #include <list>
+#include <string_view>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 namespace oatpp { namespace swagger {
 
@@ -54,10 +59,124 @@ public:
   
   typedef Fields<Object<oas3::PathItem>> Paths;
   
-  typedef std::unordered_map<oatpp::String, const Type*> UsedTypes;
+  /**
+   * Set of types referenced from the document. Keeps the order in which the types were first referenced.
+   */
+  class UsedTypes {
+  private:
+    std::unordered_set<const Type*> m_types;
+    std::vector<const Type*> m_order;
+  public:
+
+    /**
+     * Add type.
+     * @param type
+     * @return - `true` if the type was not in the set.
+     */
+    bool insert(const Type* type) {
+      if(m_types.insert(type).second) {
+        m_order.push_back(type);
+        return true;
+      }
+      return false;
+    }
+
+    /**
+     * Get types in the order they were first added.
+     * @return
+     */
+    const std::vector<const Type*>& getOrder() const {
+      return m_order;
+    }
+
+  };
+
+  /**
+   * Types which should be placed to components/schemas.
+   */
+  typedef std::vector<const Type*> DecomposedTypes;
 
   typedef std::unordered_map<oatpp::String, bool> UsedSecuritySchemes;
 
+  /**
+   * Statistics of the document generation.
+   */
+  struct Stats {
+
+    /**
+     * Wall time of the paths generation phase in microseconds.
+     */
+    v_int64 pathsMicros = 0;
+
+    /**
+     * Wall time of the types decomposition phase in microseconds.
+     */
+    v_int64 decompositionMicros = 0;
+
+    /**
+     * Wall time of the components/schemas generation phase in microseconds.
+     */
+    v_int64 componentsMicros = 0;
+
+    /**
+     * Wall time of the components/securitySchemes generation phase in microseconds.
+     */
+    v_int64 securitySchemesMicros = 0;
+
+    /**
+     * Wall time of the schemas deduplication in microseconds. `0` if deduplication is disabled.
+     */
+    v_int64 deduplicationMicros = 0;
+
+    /**
+     * Total wall time of &l:Generator::generateDocument (); in microseconds.
+     */
+    v_int64 totalMicros = 0;
+
+    /**
+     * Number of documented (not hidden) endpoints.
+     */
+    v_int64 endpointsCount = 0;
+
+    /**
+     * Number of schema objects created.
+     */
+    v_int64 schemasGenerated = 0;
+
+    /**
+     * Number of times a shared simple-type schema was placed to the document as is. <br>
+     * Occurrences which needed their own copy of the schema (because of a description, pattern or default value) are not counted.
+     */
+    v_int64 schemaCacheHits = 0;
+
+    /**
+     * Number of schemas in components/schemas.
+     */
+    v_int64 componentSchemasCount = 0;
+
+    /**
+     * Number of distinct strings allocated by the string pool.
+     */
+    v_int64 stringsAllocated = 0;
+
+    /**
+     * Number of times a pooled string was reused.
+     */
+    v_int64 stringCacheHits = 0;
+
+    /**
+     * Bytes used in the document arena. `0` if arena is disabled.
+     */
+    v_int64 arenaSize = 0;
+
+    /**
+     * Size of the serialized document in bytes. <br>
+     * Generator doesn't serialize the document - this field is filled by the swagger controllers. `-1` if unknown.
+     */
+    v_int64 serializedSize = -1;
+
+  };
+
 private:
   void addParamsToParametersList(const PathItemParameters& paramsList,
                                         Endpoint::Info::Params& params,
@@ -65,8 +184,59 @@ private:
                                         UsedTypes& usedTypes);
 private:
 
+  /*
+   * Allocate new document node - DTO or container.
+   * Node is allocated in the document arena if arena is enabled in &l:Generator::Config;.
+   */
+  template<class Wrapper>
+  Wrapper allocate() {
+    typedef typename Wrapper::ObjectType ObjectType;
+    if(m_arena) {
+      return Wrapper(std::allocate_shared<ObjectType>(ArenaAllocator<ObjectType>(m_arena)));
+    }
+    return Wrapper(std::make_shared<ObjectType>());
+  }
+
+private:
+
+  static v_int64 getMicrosSince(const std::chrono::steady_clock::time_point& start);
+
+  oatpp::Object<oas3::Schema> createSchema();
+
+  oatpp::Object<oas3::Schema> createSimpleSchema(const oatpp::String& type,
+                                                 const oatpp::String& format,
+                                                 const oatpp::Int64& minimum,
+                                                 const oatpp::Int64& maximum);
+  void initSimpleSchemas();
+
+  /*
+   * Schemas from the simple-type table are shared between all occurrences and are never mutated.
+   * Returns a copy of the schema if it is a shared one, or the schema itself otherwise.
+   * A copied schema is not reused - it is taken back from &l:Generator::Stats::schemaCacheHits;.
+   */
+  oatpp::Object<oas3::Schema> getMutableSchema(const oatpp::Object<oas3::Schema>& schema);
+
+private:
+
+  /*
+   * String interning. Each distinct string value is materialized once per document and shared by all its nodes.
+   */
+  oatpp::String intern(const char* data, v_buff_size size);
+  oatpp::String intern(const char* str);
+  oatpp::String intern(const std::string& str);
+
   oatpp::String getEnumSchemaName(const Type* type);
 
+  /*
+   * Name of the type in components/schemas. Computed once per type.
+   */
+  oatpp::String getSchemaName(const Type* type);
+
+  /*
+   * `#/components/schemas/<name>` reference to the type. Computed once per type.
+   */
+  oatpp::String getSchemaRef(const Type* type);
+
   oatpp::Object<oas3::Schema> generateSchemaForSimpleType(const Type* type, oatpp::BaseObject::Property* property = nullptr, const oatpp::Void& defaultValue = nullptr);
   oatpp::Object<oas3::Schema> generateSchemaForCollection_1D(const Type* type, bool linkSchema, UsedTypes& usedTypes, bool uniqueItems);
   oatpp::Object<oas3::Schema> generateSchemaForTypeObject(const Type* type, bool linkSchema, UsedTypes& usedTypes);
@@ -78,21 +248,23 @@ private:
   Fields<Object<oas3::OperationResponse>> generateResponses(const Endpoint::Info& endpointInfo, bool linkSchema, UsedTypes& usedTypes);
   void generatePathItemData(const std::shared_ptr<Endpoint>& endpoint, const oatpp::Object<oas3::PathItem>& pathItem, UsedTypes& usedTypes, UsedSecuritySchemes &usedSecuritySchemes);
   
+  oatpp::Object<oas3::SecurityScheme> generateSecurityScheme(const std::shared_ptr<oatpp::swagger::SecurityScheme> &ss);
+
+private:
+
   /*
    *  UsedTypes& usedTypes is used to put Types of objects whos schema should be reused
    */
   Paths generatePaths(const Endpoints& endpoints, UsedTypes& usedTypes, UsedSecuritySchemes &usedSecuritySchemes);
 
-  oatpp::Object<oas3::SecurityScheme> generateSecurityScheme(const std::shared_ptr<oatpp::swagger::SecurityScheme> &ss);
-
-  void decomposeObject(const Type* type, UsedTypes& decomposedTypes);
-  void decomposeCollection_1D(const Type* type, UsedTypes& decomposedTypes);
-  void decomposeMap(const Type* type, UsedTypes& decomposedTypes);
-  void decomposeEnum(const Type* type, UsedTypes& decomposedTypes);
-  void decomposeType(const Type* type, UsedTypes& decomposedTypes);
-  UsedTypes decomposeTypes(UsedTypes& usedTypes);
+  /*
+   * Walk the graph of used types with an explicit worklist and collect all object and enum types reachable from them.
+   * Each type is visited once. The result is sorted by the schema name. Types with the same name keep the order
+   * in which they were referenced from the endpoints, so the first one is the same on every run.
+   */
+  DecomposedTypes decomposeTypes(const UsedTypes& usedTypes);
   
-  oatpp::Object<oas3::Components> generateComponents(const UsedTypes &decomposedTypes,
+  oatpp::Object<oas3::Components> generateComponents(const DecomposedTypes &decomposedTypes,
                                                      const std::shared_ptr<std::unordered_map<oatpp::String,std::shared_ptr<oatpp::swagger::SecurityScheme>>> &securitySchemes,
                                                      UsedSecuritySchemes &usedSecuritySchemes);
 
@@ -105,10 +277,59 @@ public:
      */
     std::vector<std::string> enableInterpretations = {};
 
+    /**
+     * Allocate nodes of the generated document (schemas, parameters, media types, containers, etc.) from an arena. <br>
+     * Each generated document gets its own arena which is released in one step together with the last node of the document.
+     */
+    bool useArena = false;
+
+    /**
+     * Size of a single arena chunk in bytes. Used only if `useArena == true`.
+     */
+    v_buff_size arenaChunkSize = 64 * 1024;
+
+    /**
+     * Detect structurally equal schemas in the generated document and share one instance of each in memory.
+     * See &id:oatpp::swagger::Deduplicator;.
+     */
+    bool deduplicateSchemas = false;
+
+    /**
+     * Hoist complex inline schemas which occur more than once to `components/schemas` and reference them via `$ref`.
+     * Used only if `deduplicateSchemas == true`.
+     */
+    bool hoistDuplicateSchemas = false;
+
+    /**
+     * Leave out fields which are empty, equal to their defaults or implied by other fields: <br>
+     * empty `required` and `parameters` lists, `required: false` and `deprecated: false`, minimum/maximum of 32-bit integers
+     * (`format: int32` is used instead) and default values next to `$ref`. <br>
+     * Operations without declared responses keep the generated `"200": {"description": "success"}` -
+     * Open Api requires at least one response per operation, and a description for each response. <br>
+     * The swagger controllers also serialize the document without escaping `/` and non-ASCII characters.
+     */
+    bool compact = false;
+
+    /**
+     * Log &l:Generator::Stats; of the document generated by the swagger controllers on the debug level.
+     */
+    bool logStats = false;
+
   };
 
 private:
   std::shared_ptr<Config> m_config;
+  std::unordered_map<v_int32, oatpp::Object<oas3::Schema>> m_simpleSchemas;
+  std::unordered_set<const oas3::Schema*> m_sharedSchemas;
+  std::shared_ptr<Arena> m_arena;
+  Stats m_stats;
+private:
+  /*
+   * Per-document caches. Cleared at the end of each generateDocument() call.
+   */
+  std::unordered_map<std::string_view, oatpp::String> m_strings;
+  std::unordered_map<const Type*, oatpp::String> m_schemaNames;
+  std::unordered_map<const Type*, oatpp::String> m_schemaRefs;
 public:
 
   Generator(const std::shared_ptr<Config>& config);
@@ -121,6 +342,19 @@ public:
    */
   oatpp::Object<oas3::Document> generateDocument(const std::shared_ptr<oatpp::swagger::DocumentInfo>& docInfo, const Endpoints& endpoints);
 
+  /**
+   * Get statistics of the last &l:Generator::generateDocument (); call of this generator.
+   * @return - &l:Generator::Stats;.
+   */
+  const Stats& getStats() const;
+
+  /**
+   * Log &l:Generator::Stats; on the debug level.
+   * @param tag - log tag.
+   * @param stats - &l:Generator::Stats;.
+   */
+  static void logStats(const char* tag, const Stats& stats);
+
 };
   
 }}
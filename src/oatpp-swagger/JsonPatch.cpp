@@ -0,0 +1,233 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi, <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "JsonPatch.hpp"
+
+#include "oatpp-swagger/DocumentFragments.hpp"
+
+#include "oatpp/json/ObjectMapper.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+
+namespace oatpp { namespace swagger {
+
+namespace {
+
+  bool isObject(const oatpp::Type* type) {
+    return type->classId.id == oatpp::data::type::__class::AbstractObject::CLASS_ID.id;
+  }
+
+  bool isList(const oatpp::Type* type) {
+    return type->classId.id == oatpp::data::type::__class::AbstractList::CLASS_ID.id ||
+           type->classId.id == oatpp::data::type::__class::AbstractVector::CLASS_ID.id;
+  }
+
+  bool isMap(const oatpp::Type* type) {
+    return type->classId.id == oatpp::data::type::__class::AbstractPairList::CLASS_ID.id ||
+           type->classId.id == oatpp::data::type::__class::AbstractUnorderedMap::CLASS_ID.id;
+  }
+
+}
+
+JsonPatch::JsonPatch(const std::shared_ptr<data::mapping::ObjectMapper>& objectMapper, const oatpp::Void& from, const oatpp::Void& to)
+  : m_objectMapper(objectMapper)
+  , m_nullFields(true)
+  , m_nullElements(true)
+  , m_operationsCount(0)
+{
+  auto jsonMapper = std::dynamic_pointer_cast<oatpp::json::ObjectMapper>(objectMapper);
+  if(jsonMapper) {
+    const auto& config = jsonMapper->serializerConfig().mapper;
+    m_nullFields = config.includeNullFields;
+    m_nullElements = config.includeNullFields || config.alwaysIncludeNullCollectionElements;
+  }
+  diff(from, to, "", true);
+}
+
+void JsonPatch::addOperation(const char* op, const std::string& path, const oatpp::Void& value) {
+
+  if(m_operationsCount > 0) {
+    m_operations.push_back(',');
+  }
+
+  m_operations.append("{\"op\":\"");
+  m_operations.append(op);
+  m_operations.append("\",\"path\":");
+  m_operations.append(*m_objectMapper->writeToString(oatpp::String(path)));
+
+  if(std::strcmp(op, "remove") != 0) {
+    m_operations.append(",\"value\":");
+    m_operations.append(value ? *m_objectMapper->writeToString(value) : std::string("null"));
+  }
+
+  m_operations.push_back('}');
+  m_operationsCount ++;
+
+}
+
+void JsonPatch::diff(const oatpp::Void& from, const oatpp::Void& to, const std::string& path, bool nullWritten) {
+
+  // Same sub-tree, or null in both.
+  if(from.get() == to.get()) {
+    return;
+  }
+
+  if(!from) {
+    // Written null is a present value - replace it.
+    addOperation(nullWritten ? "replace" : "add", path, to);
+    return;
+  }
+
+  if(!to) {
+    if(nullWritten) {
+      addOperation("replace", path, nullptr);
+    } else {
+      addOperation("remove", path, nullptr);
+    }
+    return;
+  }
+
+  auto type = from.getValueType();
+
+  if(type != to.getValueType()) {
+    addOperation("replace", path, to);
+  } else if(isObject(type)) {
+    diffObjects(from, to, path);
+  } else if(isList(type)) {
+    diffLists(from, to, path);
+  } else if(isMap(type)) {
+    diffMaps(from, to, path);
+  } else if(*m_objectMapper->writeToString(from) != *m_objectMapper->writeToString(to)) {
+    addOperation("replace", path, to);
+  }
+
+}
+
+void JsonPatch::diffObjects(const oatpp::Void& from, const oatpp::Void& to, const std::string& path) {
+  auto dispatcher = static_cast<const oatpp::data::type::__class::AbstractObject::PolymorphicDispatcher*>(
+    from.getValueType()->polymorphicDispatcher
+  );
+  for(auto* p : dispatcher->getProperties()->getList()) {
+    diff(p->get(static_cast<oatpp::BaseObject*>(from.get())),
+         p->get(static_cast<oatpp::BaseObject*>(to.get())),
+         path + "/" + DocumentFragments::escapeToken(p->name),
+         m_nullFields);
+  }
+}
+
+void JsonPatch::diffLists(const oatpp::Void& from, const oatpp::Void& to, const std::string& path) {
+
+  auto dispatcher = static_cast<const oatpp::data::type::__class::Collection::PolymorphicDispatcher*>(
+    from.getValueType()->polymorphicDispatcher
+  );
+
+  // Indices are the ones of the written array - null elements which are not written are skipped.
+  std::vector<oatpp::Void> fromItems;
+  for(auto it = dispatcher->beginIteration(from); !it->finished(); it->next()) {
+    auto item = it->get();
+    if(item || m_nullElements) {
+      fromItems.push_back(item);
+    }
+  }
+
+  std::vector<oatpp::Void> toItems;
+  for(auto it = dispatcher->beginIteration(to); !it->finished(); it->next()) {
+    auto item = it->get();
+    if(item || m_nullElements) {
+      toItems.push_back(item);
+    }
+  }
+
+  auto common = std::min(fromItems.size(), toItems.size());
+
+  for(size_t i = 0; i < common; i++) {
+    diff(fromItems[i], toItems[i], path + "/" + std::to_string(i), true);
+  }
+
+  // remove from the end so that indices of the remaining items don't change
+  for(size_t i = fromItems.size(); i > common; i--) {
+    addOperation("remove", path + "/" + std::to_string(i - 1), nullptr);
+  }
+
+  for(size_t i = common; i < toItems.size(); i++) {
+    addOperation("add", path + "/-", toItems[i]);
+  }
+
+}
+
+void JsonPatch::diffMaps(const oatpp::Void& from, const oatpp::Void& to, const std::string& path) {
+
+  auto dispatcher = static_cast<const oatpp::data::type::__class::Map::PolymorphicDispatcher*>(
+    from.getValueType()->polymorphicDispatcher
+  );
+
+  std::unordered_map<std::string, oatpp::Void> toItems;
+  std::vector<std::string> toKeys;
+  // Keys with null values which are not written are absent.
+  for(auto it = dispatcher->beginIteration(to); !it->finished(); it->next()) {
+    auto key = it->getKey();
+    if(key && (it->getValue() || m_nullElements)) {
+      auto& k = *static_cast<std::string*>(key.get());
+      toItems[k] = it->getValue();
+      toKeys.push_back(k);
+    }
+  }
+
+  std::unordered_map<std::string, bool> fromKeys;
+  for(auto it = dispatcher->beginIteration(from); !it->finished(); it->next()) {
+    auto key = it->getKey();
+    if(!key || !(it->getValue() || m_nullElements)) {
+      continue;
+    }
+    auto& k = *static_cast<std::string*>(key.get());
+    fromKeys[k] = true;
+    auto toItem = toItems.find(k);
+    if(toItem == toItems.end()) {
+      addOperation("remove", path + "/" + DocumentFragments::escapeToken(k), nullptr);
+    } else {
+      diff(it->getValue(), toItem->second, path + "/" + DocumentFragments::escapeToken(k), true);
+    }
+  }
+
+  for(auto& k : toKeys) {
+    if(fromKeys.find(k) == fromKeys.end()) {
+      addOperation("add", path + "/" + DocumentFragments::escapeToken(k), toItems[k]);
+    }
+  }
+
+}
+
+oatpp::String JsonPatch::toString() const {
+  return "[" + m_operations + "]";
+}
+
+v_int64 JsonPatch::getOperationsCount() const {
+  return m_operationsCount;
+}
+
+}}
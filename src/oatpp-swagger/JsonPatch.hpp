@@ -0,0 +1,85 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi, <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef oatpp_swagger_JsonPatch_hpp
+#define oatpp_swagger_JsonPatch_hpp
+
+#include "oatpp/data/mapping/ObjectMapper.hpp"
+#include "oatpp/Types.hpp"
+
+#include <string>
+
+namespace oatpp { namespace swagger {
+
+/**
+ * JSON Patch (RFC 6902) between two DTO trees. <br>
+ * Objects are compared property by property, maps key by key and lists element by element
+ * (elements are added or removed at the end). All other values are compared by their serialized form and replaced if different.
+ * Sub-trees shared by both documents are skipped without comparison. <br>
+ * `null` values are patched the way the object mapper writes them. If the mapper is &id:oatpp::json::ObjectMapper;,
+ * a `null` property is present in JSON only with `includeNullFields`, and a `null` list element or map value only with
+ * `includeNullFields` or `alwaysIncludeNullCollectionElements`. Values that are not written are patched as absent.
+ * Other mappers are assumed to write all `null` values.
+ */
+class JsonPatch {
+private:
+  std::shared_ptr<data::mapping::ObjectMapper> m_objectMapper;
+  bool m_nullFields;
+  bool m_nullElements;
+  std::string m_operations;
+  v_int64 m_operationsCount;
+private:
+  void addOperation(const char* op, const std::string& path, const oatpp::Void& value);
+  void diff(const oatpp::Void& from, const oatpp::Void& to, const std::string& path, bool nullWritten);
+  void diffObjects(const oatpp::Void& from, const oatpp::Void& to, const std::string& path);
+  void diffLists(const oatpp::Void& from, const oatpp::Void& to, const std::string& path);
+  void diffMaps(const oatpp::Void& from, const oatpp::Void& to, const std::string& path);
+public:
+
+  /**
+   * Constructor. Computes the patch.
+   * @param objectMapper - &id:oatpp::data::mapping::ObjectMapper; to serialize values with.
+   * @param from - source tree.
+   * @param to - target tree.
+   */
+  JsonPatch(const std::shared_ptr<data::mapping::ObjectMapper>& objectMapper, const oatpp::Void& from, const oatpp::Void& to);
+
+  /**
+   * Get serialized patch.
+   * @return - JSON array of patch operations.
+   */
+  oatpp::String toString() const;
+
+  /**
+   * Get number of patch operations.
+   * @return - number of operations.
+   */
+  v_int64 getOperationsCount() const;
+
+};
+
+}}
+
+#endif // oatpp_swagger_JsonPatch_hpp
@@ -0,0 +1,234 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi, <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "Metrics.hpp"
+
+#include "oatpp/data/stream/BufferStream.hpp"
+
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+namespace oatpp { namespace swagger {
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Metrics::Counter
+
+v_int32 Metrics::Counter::getShardIndex() {
+  static std::atomic<v_int32> nextIndex(0);
+  thread_local v_int32 index = nextIndex.fetch_add(1, std::memory_order_relaxed) % SHARDS_COUNT;
+  return index;
+}
+
+void Metrics::Counter::increment(v_int64 delta) {
+  m_shards[getShardIndex()].value.fetch_add(delta, std::memory_order_relaxed);
+}
+
+v_int64 Metrics::Counter::get() const {
+  v_int64 result = 0;
+  for(const auto& shard : m_shards) {
+    result += shard.value.load(std::memory_order_relaxed);
+  }
+  return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Metrics
+
+Metrics::Metrics()
+  : m_generationMicros(0)
+  , m_documentSize(0)
+{}
+
+const char* Metrics::getEndpointName(Endpoint endpoint) {
+  switch(endpoint) {
+    case Endpoint::API: return "api";
+    case Endpoint::UI_ROOT: return "ui";
+    case Endpoint::INITIALIZER: return "initializer";
+    case Endpoint::UI_RESOURCE: return "ui_resource";
+    case Endpoint::METRICS: return "metrics";
+    case Endpoint::API_TAG: return "api_tag";
+    case Endpoint::API_INDEX: return "api_index";
+    case Endpoint::SEARCH: return "search";
+    case Endpoint::FRAGMENT: return "fragment";
+    case Endpoint::DELTA: return "delta";
+    case Endpoint::EVENTS: return "events";
+    case Endpoint::API_VERSION: return "api_version";
+    case Endpoint::SIZE_REPORT: return "size_report";
+    default: return "unknown";
+  }
+}
+
+Metrics::FileCounters* Metrics::getFileCounters(const oatpp::String& filename) {
+
+  {
+    std::shared_lock<std::shared_mutex> lock(m_filesMutex);
+    auto it = m_files.find(filename);
+    if(it != m_files.end()) {
+      return it->second.get();
+    }
+  }
+
+  std::unique_lock<std::shared_mutex> lock(m_filesMutex);
+  auto& counters = m_files[filename];
+  if(!counters) {
+    counters = std::make_unique<FileCounters>();
+  }
+  return counters.get();
+
+}
+
+void Metrics::recordResponse(Endpoint endpoint, const std::shared_ptr<web::protocol::http::outgoing::Response>& response) {
+  m_endpointRequests[static_cast<v_int32>(endpoint)].increment();
+  if(!response) {
+    return;
+  }
+  if(response->getStatus().code == 304) {
+    // The body of 304 declares the size of the content it doesn't send - nothing is sent.
+    m_notModified.increment();
+    return;
+  }
+  auto body = response->getBody();
+  if(body) {
+    auto size = body->getKnownSize();
+    if(size > 0) {
+      m_bytesSent.increment(size);
+    }
+  }
+}
+
+void Metrics::recordFileRequest(const oatpp::String& filename, bool cacheHit) {
+  auto counters = getFileCounters(filename);
+  counters->requests.increment();
+  if(cacheHit) {
+    counters->cacheHits.increment();
+    m_cacheHits.increment();
+  } else {
+    counters->cacheMisses.increment();
+    m_cacheMisses.increment();
+  }
+}
+
+void Metrics::recordDocument(v_int64 generationMicros, v_int64 documentSize) {
+  m_generationMicros.store(generationMicros, std::memory_order_relaxed);
+  m_documentSize.store(documentSize, std::memory_order_relaxed);
+}
+
+v_int64 Metrics::getRequestsCount(Endpoint endpoint) const {
+  return m_endpointRequests[static_cast<v_int32>(endpoint)].get();
+}
+
+v_int64 Metrics::getFileRequestsCount(const oatpp::String& filename) const {
+  std::shared_lock<std::shared_mutex> lock(m_filesMutex);
+  auto it = m_files.find(filename);
+  if(it != m_files.end()) {
+    return it->second->requests.get();
+  }
+  return 0;
+}
+
+v_int64 Metrics::getBytesSent() const {
+  return m_bytesSent.get();
+}
+
+v_int64 Metrics::getCacheHits() const {
+  return m_cacheHits.get();
+}
+
+v_int64 Metrics::getCacheMisses() const {
+  return m_cacheMisses.get();
+}
+
+v_int64 Metrics::getNotModifiedCount() const {
+  return m_notModified.get();
+}
+
+v_int64 Metrics::getGenerationMicros() const {
+  return m_generationMicros.load(std::memory_order_relaxed);
+}
+
+v_int64 Metrics::getDocumentSize() const {
+  return m_documentSize.load(std::memory_order_relaxed);
+}
+
+oatpp::String Metrics::toPrometheusText() const {
+
+  data::stream::BufferOutputStream stream;
+
+  stream << "# HELP oatpp_swagger_requests_total Requests to the swagger controller endpoints.\n";
+  stream << "# TYPE oatpp_swagger_requests_total counter\n";
+  for(v_int32 i = 0; i < static_cast<v_int32>(Endpoint::ENDPOINTS_COUNT); i++) {
+    stream << "oatpp_swagger_requests_total{endpoint=\"" << getEndpointName(static_cast<Endpoint>(i)) << "\"} "
+           << m_endpointRequests[i].get() << "\n";
+  }
+
+  {
+    std::shared_lock<std::shared_mutex> lock(m_filesMutex);
+
+    std::vector<const std::string*> names;
+    names.reserve(m_files.size());
+    for(auto& file : m_files) {
+      names.push_back(&file.first);
+    }
+    std::sort(names.begin(), names.end(), [](const std::string* a, const std::string* b) { return *a < *b; });
+
+    stream << "# HELP oatpp_swagger_resource_requests_total Requests to the swagger-ui resource files.\n";
+    stream << "# TYPE oatpp_swagger_resource_requests_total counter\n";
+    for(auto name : names) {
+      auto& counters = m_files.at(*name);
+      stream << "oatpp_swagger_resource_requests_total{file=\"" << name->c_str() << "\",cache=\"hit\"} " << counters->cacheHits.get() << "\n";
+      stream << "oatpp_swagger_resource_requests_total{file=\"" << name->c_str() << "\",cache=\"miss\"} " << counters->cacheMisses.get() << "\n";
+    }
+  }
+
+  stream << "# HELP oatpp_swagger_sent_bytes_total Response body bytes sent by the swagger controllers (known-size bodies only).\n";
+  stream << "# TYPE oatpp_swagger_sent_bytes_total counter\n";
+  stream << "oatpp_swagger_sent_bytes_total " << m_bytesSent.get() << "\n";
+
+  stream << "# HELP oatpp_swagger_cache_hits_total Resource requests served from memory.\n";
+  stream << "# TYPE oatpp_swagger_cache_hits_total counter\n";
+  stream << "oatpp_swagger_cache_hits_total " << m_cacheHits.get() << "\n";
+
+  stream << "# HELP oatpp_swagger_cache_misses_total Resource requests read from disk.\n";
+  stream << "# TYPE oatpp_swagger_cache_misses_total counter\n";
+  stream << "oatpp_swagger_cache_misses_total " << m_cacheMisses.get() << "\n";
+
+  stream << "# HELP oatpp_swagger_not_modified_total 304 Not Modified responses.\n";
+  stream << "# TYPE oatpp_swagger_not_modified_total counter\n";
+  stream << "oatpp_swagger_not_modified_total " << m_notModified.get() << "\n";
+
+  stream << "# HELP oatpp_swagger_generation_microseconds Time to generate the API document.\n";
+  stream << "# TYPE oatpp_swagger_generation_microseconds gauge\n";
+  stream << "oatpp_swagger_generation_microseconds " << getGenerationMicros() << "\n";
+
+  stream << "# HELP oatpp_swagger_document_bytes Size of the serialized API document.\n";
+  stream << "# TYPE oatpp_swagger_document_bytes gauge\n";
+  stream << "oatpp_swagger_document_bytes " << getDocumentSize() << "\n";
+
+  return stream.toString();
+
+}
+
+}}
@@ -0,0 +1,213 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi, <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef oatpp_swagger_Metrics_hpp
+#define oatpp_swagger_Metrics_hpp
+
+#include "oatpp/web/protocol/http/outgoing/Response.hpp"
+#include "oatpp/Types.hpp"
+
+#include <atomic>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+
+namespace oatpp { namespace swagger {
+
+/**
+ * Runtime metrics of the swagger controllers and of the &id:oatpp::swagger::Resources; files they serve. <br>
+ * Register `std::shared_ptr<Metrics>` as a component to enable metrics. Metrics can be pulled via getters or
+ * exported in Prometheus text format via &l:Metrics::toPrometheusText (); (served at &id:oatpp::swagger::ControllerPaths::metrics;).
+ */
+class Metrics {
+public:
+
+  /**
+   * Counter sharded across threads. <br>
+   * Each thread increments its own cache-line-aligned shard, so that concurrent requests don't contend on a single atomic.
+   * Shards are summed on read.
+   */
+  class Counter {
+  public:
+    static constexpr v_int32 SHARDS_COUNT = 16;
+  private:
+    struct alignas(64) Shard {
+      std::atomic<v_int64> value {0};
+    };
+  private:
+    static v_int32 getShardIndex();
+  private:
+    Shard m_shards[SHARDS_COUNT];
+  public:
+
+    /**
+     * Add value to the counter.
+     * @param delta
+     */
+    void increment(v_int64 delta = 1);
+
+    /**
+     * Get current value of the counter.
+     * @return
+     */
+    v_int64 get() const;
+
+  };
+
+public:
+
+  /**
+   * Endpoints of the swagger controllers.
+   */
+  enum class Endpoint : v_int32 {
+    API = 0,
+    UI_ROOT = 1,
+    INITIALIZER = 2,
+    UI_RESOURCE = 3,
+    METRICS = 4,
+    API_TAG = 5,
+    API_INDEX = 6,
+    SEARCH = 7,
+    FRAGMENT = 8,
+    DELTA = 9,
+    EVENTS = 10,
+    API_VERSION = 11,
+    SIZE_REPORT = 12,
+    ENDPOINTS_COUNT = 13
+  };
+
+private:
+
+  struct FileCounters {
+    Counter requests;
+    Counter cacheHits;
+    Counter cacheMisses;
+  };
+
+private:
+  static const char* getEndpointName(Endpoint endpoint);
+private:
+  Counter m_endpointRequests[static_cast<v_int32>(Endpoint::ENDPOINTS_COUNT)];
+  Counter m_bytesSent;
+  Counter m_cacheHits;
+  Counter m_cacheMisses;
+  Counter m_notModified;
+  std::atomic<v_int64> m_generationMicros;
+  std::atomic<v_int64> m_documentSize;
+private:
+  mutable std::shared_mutex m_filesMutex;
+  std::unordered_map<std::string, std::unique_ptr<FileCounters>> m_files;
+private:
+  FileCounters* getFileCounters(const oatpp::String& filename);
+public:
+
+  /**
+   * Constructor.
+   */
+  Metrics();
+
+  /**
+   * Record a request to the controller endpoint.
+   * @param endpoint - &l:Metrics::Endpoint;.
+   * @param response - response sent. Body size is counted if known. `304` responses are counted as not-modified and send no bytes.
+   */
+  void recordResponse(Endpoint endpoint, const std::shared_ptr<web::protocol::http::outgoing::Response>& response);
+
+  /**
+   * Record a request to the resource file.
+   * @param filename - name of the resource file.
+   * @param cacheHit - `true` if resource was served from memory, `false` if it was read from disk.
+   */
+  void recordFileRequest(const oatpp::String& filename, bool cacheHit);
+
+  /**
+   * Record the published document.
+   * @param generationMicros - document generation time in microseconds. `0` if unknown.
+   * @param documentSize - size of the serialized document in bytes.
+   */
+  void recordDocument(v_int64 generationMicros, v_int64 documentSize);
+
+  /**
+   * Get number of requests to the controller endpoint.
+   * @param endpoint - &l:Metrics::Endpoint;.
+   * @return
+   */
+  v_int64 getRequestsCount(Endpoint endpoint) const;
+
+  /**
+   * Get number of requests to the resource file.
+   * @param filename - name of the resource file.
+   * @return
+   */
+  v_int64 getFileRequestsCount(const oatpp::String& filename) const;
+
+  /**
+   * Get total number of response body bytes with known size sent by the controllers.
+   * @return
+   */
+  v_int64 getBytesSent() const;
+
+  /**
+   * Get number of resource requests served from memory.
+   * @return
+   */
+  v_int64 getCacheHits() const;
+
+  /**
+   * Get number of resource requests read from disk.
+   * @return
+   */
+  v_int64 getCacheMisses() const;
+
+  /**
+   * Get number of `304 Not Modified` responses.
+   * @return
+   */
+  v_int64 getNotModifiedCount() const;
+
+  /**
+   * Get generation time of the last published document in microseconds. `0` if unknown.
+   * @return
+   */
+  v_int64 getGenerationMicros() const;
+
+  /**
+   * Get serialized size of the last published document in bytes.
+   * @return
+   */
+  v_int64 getDocumentSize() const;
+
+  /**
+   * Render all metrics in Prometheus text exposition format.
+   * @return
+   */
+  oatpp::String toPrometheusText() const;
+
+};
+
+}}
+
+#endif // oatpp_swagger_Metrics_hpp
@@ -0,0 +1,85 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi, <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "OperationIndex.hpp"
+
+#include "oatpp-swagger/ResponseFactory.hpp"
+
+#include <utility>
+
+namespace oatpp { namespace swagger {
+
+OperationIndex::OperationIndex(const std::shared_ptr<data::mapping::ObjectMapper>& objectMapper, const oatpp::Object<oas3::Document>& document)
+  : m_entries(oatpp::List<oatpp::Object<OperationIndexEntry>>::createShared())
+{
+
+  if(document->paths) {
+    for(auto& path : *document->paths) {
+
+      const auto& item = path.second;
+      const std::pair<const char*, oatpp::Object<oas3::PathItemOperation>> operations[] = {
+        {"GET", item->operationGet},
+        {"PUT", item->operationPut},
+        {"POST", item->operationPost},
+        {"DELETE", item->operationDelete},
+        {"OPTIONS", item->operationOptions},
+        {"HEAD", item->operationHead},
+        {"PATCH", item->operationPatch},
+        {"TRACE", item->operationTrace}
+      };
+
+      for(auto& operation : operations) {
+        if(operation.second) {
+          auto entry = OperationIndexEntry::createShared();
+          entry->method = operation.first;
+          entry->path = path.first;
+          entry->operationId = operation.second->operationId;
+          entry->summary = operation.second->summary;
+          entry->tags = operation.second->tags;
+          m_entries->push_back(entry);
+        }
+      }
+
+    }
+  }
+
+  m_data = objectMapper->writeToString(m_entries);
+  m_etag = ResponseFactory::createETag(m_data->data(), static_cast<v_buff_size>(m_data->size()));
+
+}
+
+oatpp::List<oatpp::Object<OperationIndexEntry>> OperationIndex::getEntries() const {
+  return m_entries;
+}
+
+oatpp::String OperationIndex::getData() const {
+  return m_data;
+}
+
+oatpp::String OperationIndex::getETag() const {
+  return m_etag;
+}
+
+}}
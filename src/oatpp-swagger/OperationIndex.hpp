@@ -0,0 +1,114 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi, <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef oatpp_swagger_OperationIndex_hpp
+#define oatpp_swagger_OperationIndex_hpp
+
+#include "oatpp-swagger/oas3/Model.hpp"
+
+#include "oatpp/data/mapping/ObjectMapper.hpp"
+#include "oatpp/macro/codegen.hpp"
+
+namespace oatpp { namespace swagger {
+
+#include OATPP_CODEGEN_BEGIN(DTO)
+
+/**
+ * Entry of the &l:OperationIndex;.
+ */
+class OperationIndexEntry : public oatpp::DTO {
+
+  DTO_INIT(OperationIndexEntry, DTO)
+
+  /**
+   * HTTP method in upper case.
+   */
+  DTO_FIELD(String, method);
+
+  /**
+   * Path as it appears in the document `paths`.
+   */
+  DTO_FIELD(String, path);
+
+  /**
+   * Operation ID.
+   */
+  DTO_FIELD(String, operationId);
+
+  /**
+   * Summary.
+   */
+  DTO_FIELD(String, summary);
+
+  /**
+   * List of tags.
+   */
+  DTO_FIELD(List<String>, tags);
+
+};
+
+#include OATPP_CODEGEN_END(DTO)
+
+/**
+ * Compact index of all operations of the API document - method, path, operationId, summary and tags. <br>
+ * No schemas or parameters. Built and serialized once together with the document.
+ */
+class OperationIndex {
+private:
+  oatpp::List<oatpp::Object<OperationIndexEntry>> m_entries;
+  oatpp::String m_data;
+  oatpp::String m_etag;
+public:
+
+  /**
+   * Constructor. Builds and serializes the index.
+   * @param objectMapper - &id:oatpp::data::mapping::ObjectMapper; to serialize the index with.
+   * @param document - &id:oatpp::swagger::oas3::Document;.
+   */
+  OperationIndex(const std::shared_ptr<data::mapping::ObjectMapper>& objectMapper, const oatpp::Object<oas3::Document>& document);
+
+  /**
+   * Get index entries in order of the document `paths`.
+   * @return - list of &l:OperationIndexEntry;.
+   */
+  oatpp::List<oatpp::Object<OperationIndexEntry>> getEntries() const;
+
+  /**
+   * Get serialized index.
+   * @return - serialized index (JSON array).
+   */
+  oatpp::String getData() const;
+
+  /**
+   * Get ETag of the serialized index.
+   * @return - quoted ETag.
+   */
+  oatpp::String getETag() const;
+
+};
+
+}}
+
+#endif // oatpp_swagger_OperationIndex_hpp
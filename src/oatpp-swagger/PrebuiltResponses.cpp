@@ -0,0 +1,103 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi, <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "PrebuiltResponses.hpp"
+
+#include "oatpp-swagger/ResourceBody.hpp"
+
+namespace oatpp { namespace swagger {
+
+bool PrebuiltResponses::canServe(const std::shared_ptr<IncomingRequest>& request) {
+  if(!request) {
+    return true;
+  }
+  return !request->getHeader("If-None-Match") && !request->getHeader("Range") && !request->getHeader("If-Range");
+}
+
+void PrebuiltResponses::add(Entries& entries, const oatpp::String& key, const ResponseFactory::Content& content) {
+
+  Entry entry;
+  entry.data = content.data;
+  entry.headers.put("Accept-Ranges", "bytes");
+  if(content.etag) {
+    entry.headers.put("ETag", content.etag);
+  }
+  if(content.contentType) {
+    entry.headers.put("Content-Type", content.contentType);
+  }
+  for(const auto& header : content.headers) {
+    entry.headers.put(header.first, header.second);
+  }
+
+  entries[key] = std::move(entry);
+
+}
+
+std::shared_ptr<PrebuiltResponses::OutgoingResponse> PrebuiltResponses::get(const Entries& entries,
+                                                                            const oatpp::String& key,
+                                                                            const std::shared_ptr<IncomingRequest>& request)
+{
+
+  if(entries.empty() || !canServe(request)) {
+    return nullptr;
+  }
+
+  auto it = entries.find(key);
+  if(it == entries.end()) {
+    return nullptr;
+  }
+
+  const auto& entry = it->second;
+  auto response = OutgoingResponse::createShared(web::protocol::http::Status::CODE_200, std::make_shared<ResourceBody>(entry.data));
+  response->getHeaders() = entry.headers;
+  return response;
+
+}
+
+void PrebuiltResponses::addEndpoint(const oatpp::String& path, const ResponseFactory::Content& content) {
+  add(m_endpoints, path, content);
+}
+
+void PrebuiltResponses::addResource(const oatpp::String& filename, const ResponseFactory::Content& content) {
+  add(m_resources, filename, content);
+}
+
+std::shared_ptr<PrebuiltResponses::OutgoingResponse> PrebuiltResponses::getEndpoint(const oatpp::String& path,
+                                                                                    const std::shared_ptr<IncomingRequest>& request) const
+{
+  return get(m_endpoints, path, request);
+}
+
+std::shared_ptr<PrebuiltResponses::OutgoingResponse> PrebuiltResponses::getResource(const oatpp::String& filename,
+                                                                                    const std::shared_ptr<IncomingRequest>& request) const
+{
+  return get(m_resources, filename, request);
+}
+
+v_int64 PrebuiltResponses::getSize() const {
+  return static_cast<v_int64>(m_endpoints.size() + m_resources.size());
+}
+
+}}
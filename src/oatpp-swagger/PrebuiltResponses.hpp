@@ -0,0 +1,112 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi, <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef oatpp_swagger_PrebuiltResponses_hpp
+#define oatpp_swagger_PrebuiltResponses_hpp
+
+#include "oatpp-swagger/ResponseFactory.hpp"
+
+#include <unordered_map>
+
+namespace oatpp { namespace swagger {
+
+/**
+ * Responses for the static content assembled once. <br>
+ * The status, the complete header set and the body data of each response are built once.
+ * Per request the prebuilt headers are copied into a new response object together with a new body reader over the shared data -
+ * response objects and body readers hold per-connection state and can't be shared between requests. <br>
+ * Responses of the controller endpoints and of the resource files are kept apart, so that a path can't shadow a file name. <br>
+ * Only plain requests can be answered with a prebuilt response -
+ * requests with conditional or range headers should go through &id:oatpp::swagger::ResponseFactory;.
+ */
+class PrebuiltResponses {
+public:
+  typedef ResponseFactory::IncomingRequest IncomingRequest;
+  typedef ResponseFactory::OutgoingResponse OutgoingResponse;
+private:
+
+  struct Entry {
+    oatpp::String data;
+    web::protocol::http::Headers headers;
+  };
+
+  typedef std::unordered_map<oatpp::String, Entry> Entries;
+
+private:
+  static void add(Entries& entries, const oatpp::String& key, const ResponseFactory::Content& content);
+  static std::shared_ptr<OutgoingResponse> get(const Entries& entries, const oatpp::String& key, const std::shared_ptr<IncomingRequest>& request);
+private:
+  Entries m_endpoints;
+  Entries m_resources;
+public:
+
+  /**
+   * Check if the request can be answered with a prebuilt response.
+   * @param request - incoming request. May be `nullptr`.
+   * @return - `true` if the request has no conditional or range headers.
+   */
+  static bool canServe(const std::shared_ptr<IncomingRequest>& request);
+
+  /**
+   * Add prebuilt response of the controller endpoint.
+   * @param path - endpoint path (&id:oatpp::swagger::ControllerPaths;).
+   * @param content - &id:oatpp::swagger::ResponseFactory::Content;.
+   */
+  void addEndpoint(const oatpp::String& path, const ResponseFactory::Content& content);
+
+  /**
+   * Add prebuilt response of the resource file.
+   * @param filename - name of the resource file.
+   * @param content - &id:oatpp::swagger::ResponseFactory::Content;.
+   */
+  void addResource(const oatpp::String& filename, const ResponseFactory::Content& content);
+
+  /**
+   * Get prebuilt response of the controller endpoint.
+   * @param path - endpoint path (&id:oatpp::swagger::ControllerPaths;).
+   * @param request - incoming request. May be `nullptr`.
+   * @return - response or `nullptr` if there is no response for the path or the request can't be answered with a prebuilt response.
+   */
+  std::shared_ptr<OutgoingResponse> getEndpoint(const oatpp::String& path, const std::shared_ptr<IncomingRequest>& request) const;
+
+  /**
+   * Get prebuilt response of the resource file.
+   * @param filename - name of the resource file.
+   * @param request - incoming request. May be `nullptr`.
+   * @return - response or `nullptr` if there is no response for the file or the request can't be answered with a prebuilt response.
+   */
+  std::shared_ptr<OutgoingResponse> getResource(const oatpp::String& filename, const std::shared_ptr<IncomingRequest>& request) const;
+
+  /**
+   * Number of prebuilt responses.
+   * @return
+   */
+  v_int64 getSize() const;
+
+};
+
+}}
+
+#endif // oatpp_swagger_PrebuiltResponses_hpp
@@ -0,0 +1,146 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi, <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "ResourceBody.hpp"
+
+#include "oatpp/web/protocol/http/outgoing/StreamingBody.hpp"
+#include "oatpp/data/stream/FileStream.hpp"
+#include "oatpp/base/Log.hpp"
+
+#include <cstdio>
+#include <cstring>
+
+namespace oatpp { namespace swagger {
+
+ResourceBody::ResourceBody(const oatpp::String& data, v_int64 offset, v_int64 size)
+  : m_data(data)
+  , m_stream(nullptr)
+  , m_offset(offset)
+  , m_position(0)
+  , m_skip(0)
+{
+  v_int64 dataSize = data ? static_cast<v_int64>(data->size()) : 0;
+  if(m_offset < 0 || m_offset > dataSize) {
+    m_offset = dataSize;
+  }
+  v_int64 available = dataSize - m_offset;
+  m_size = (size < 0 || size > available) ? available : size;
+}
+
+ResourceBody::ResourceBody(const std::shared_ptr<data::stream::InputStream>& stream, v_int64 size, v_int64 offset)
+  : m_data(nullptr)
+  , m_stream(stream)
+  , m_offset(offset)
+  , m_size(size)
+  , m_position(0)
+  , m_skip(offset)
+{
+  // Files can be positioned at the first byte of the range. Other streams are read and discarded up to it.
+  auto file = std::dynamic_pointer_cast<data::stream::FileInputStream>(m_stream);
+  if(m_skip > 0 && file && std::fseek(file->getFile(), static_cast<long>(m_skip), SEEK_SET) == 0) {
+    m_skip = 0;
+  }
+}
+
+std::shared_ptr<web::protocol::http::outgoing::Body> ResourceBody::createShared(const std::shared_ptr<data::resource::Resource>& resource,
+                                                                                v_int64 size,
+                                                                                v_int64 offset,
+                                                                                v_int64 length)
+{
+  auto data = resource->getInMemoryData();
+  if(data) {
+    return std::make_shared<ResourceBody>(data, offset, length);
+  }
+  if(size >= 0) {
+    if(length < 0) {
+      length = size - offset;
+    }
+    return std::make_shared<ResourceBody>(resource->openInputStream(), length, offset);
+  }
+  return std::make_shared<web::protocol::http::outgoing::StreamingBody>(resource->openInputStream());
+}
+
+v_io_size ResourceBody::onStreamEnded() {
+  // Content-Length is already sent - the client would wait for the missing bytes. Fail the body to drop the connection.
+  OATPP_LOGe("oatpp::swagger::ResourceBody::read()", "Stream ended {} bytes before the declared size of {} bytes", m_size - m_position, m_size);
+  return oatpp::IOError::BROKEN_PIPE;
+}
+
+v_io_size ResourceBody::read(void *buffer, v_buff_size count, async::Action& action) {
+
+  v_int64 remaining = m_size - m_position;
+  if(remaining <= 0) {
+    return 0;
+  }
+
+  if(count > remaining) {
+    count = static_cast<v_buff_size>(remaining);
+  }
+
+  if(m_data) {
+    std::memcpy(buffer, m_data->data() + m_offset + m_position, static_cast<size_t>(count));
+    m_position += count;
+    return count;
+  }
+
+  while(m_skip > 0) {
+    auto toSkip = m_skip < count ? static_cast<v_buff_size>(m_skip) : count;
+    auto res = m_stream->read(buffer, toSkip, action);
+    if(res == 0) {
+      return onStreamEnded();
+    }
+    if(res < 0) {
+      return res;
+    }
+    m_skip -= res;
+  }
+
+  auto res = m_stream->read(buffer, count, action);
+  if(res == 0) {
+    return onStreamEnded();
+  }
+  if(res > 0) {
+    m_position += res;
+  }
+  return res;
+
+}
+
+void ResourceBody::declareHeaders(Headers& headers) {
+  (void) headers;
+}
+
+p_char8 ResourceBody::getKnownData() {
+  if(m_data) {
+    return reinterpret_cast<p_char8>(const_cast<char*>(m_data->data() + m_offset));
+  }
+  return nullptr;
+}
+
+v_int64 ResourceBody::getKnownSize() {
+  return m_size;
+}
+
+}}
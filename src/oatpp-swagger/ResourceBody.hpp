@@ -0,0 +1,118 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi, <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef oatpp_swagger_ResourceBody_hpp
+#define oatpp_swagger_ResourceBody_hpp
+
+#include "oatpp/web/protocol/http/outgoing/Body.hpp"
+#include "oatpp/data/resource/Resource.hpp"
+#include "oatpp/Types.hpp"
+
+namespace oatpp { namespace swagger {
+
+/**
+ * Response body of a known size. <br>
+ * Serves either an in-memory string or an input stream of which the size is known upfront (ex.: file of a known size).
+ * Since the size is known the response is sent with `Content-Length` instead of the chunked transfer encoding.
+ */
+class ResourceBody : public web::protocol::http::outgoing::Body {
+private:
+  oatpp::String m_data;
+  std::shared_ptr<data::stream::InputStream> m_stream;
+  v_int64 m_offset;
+  v_int64 m_size;
+  v_int64 m_position;
+  v_int64 m_skip;
+private:
+  v_io_size onStreamEnded();
+public:
+
+  /**
+   * Constructor. Serve in-memory data or its part.
+   * @param data - data to serve.
+   * @param offset - offset of the first byte to serve.
+   * @param size - number of bytes to serve. `-1` - serve everything starting from `offset`.
+   */
+  ResourceBody(const oatpp::String& data, v_int64 offset = 0, v_int64 size = -1);
+
+  /**
+   * Constructor. Serve `size` bytes of the stream starting from `offset`. <br>
+   * &id:oatpp::data::stream::FileInputStream; is positioned at `offset` directly. From other streams the first `offset` bytes are read and discarded.
+   * If the stream ends before `offset + size` bytes, &l:ResourceBody::read (); fails with &id:oatpp::IOError::BROKEN_PIPE;.
+   * @param stream - &id:oatpp::data::stream::InputStream;.
+   * @param size - number of bytes to serve.
+   * @param offset - number of bytes to skip before serving.
+   */
+  ResourceBody(const std::shared_ptr<data::stream::InputStream>& stream, v_int64 size, v_int64 offset = 0);
+
+  /**
+   * Create body for the resource. <br>
+   * In-memory resources are served directly from memory. Other resources are streamed.
+   * If the size of the streamed resource is unknown (`size < 0`), &id:oatpp::web::protocol::http::outgoing::StreamingBody; is returned.
+   * @param resource - &id:oatpp::data::resource::Resource;.
+   * @param size - size of the resource if known (ex.: from &id:oatpp::swagger::Resources::getResourceSize;), `-1` otherwise.
+   * @param offset - offset of the first byte to serve. Used only if the size is known.
+   * @param length - number of bytes to serve. `-1` - serve everything starting from `offset`. Used only if the size is known.
+   * @return - &id:oatpp::web::protocol::http::outgoing::Body;.
+   */
+  static std::shared_ptr<web::protocol::http::outgoing::Body> createShared(const std::shared_ptr<data::resource::Resource>& resource,
+                                                                           v_int64 size,
+                                                                           v_int64 offset = 0,
+                                                                           v_int64 length = -1);
+
+  /**
+   * Read operation callback.
+   * @param buffer - pointer to buffer.
+   * @param count - size of the buffer in bytes.
+   * @param action - async specific action. If action is NOT &id:oatpp::async::Action::TYPE_NONE;, then
+   * caller MUST return this action on coroutine iteration.
+   * @return - actual number of bytes written to buffer. 0 - to indicate end-of-file.
+   */
+  v_io_size read(void *buffer, v_buff_size count, async::Action& action) override;
+
+  /**
+   * Declare headers describing body. <br>
+   * `Content-Length` is declared by the response based on &l:ResourceBody::getKnownSize ();.
+   * @param headers - &id:oatpp::web::protocol::http::Headers;.
+   */
+  void declareHeaders(Headers& headers) override;
+
+  /**
+   * Pointer to the in-memory data. `nullptr` for streamed resources.
+   * @return
+   */
+  p_char8 getKnownData() override;
+
+  /**
+   * Size of the body in bytes.
+   * @return
+   */
+  v_int64 getKnownSize() override;
+
+};
+
+}}
+
+#endif // oatpp_swagger_ResourceBody_hpp
@@ -24,11 +24,14 @@
 
 #include "Resources.hpp"
 
+#include "oatpp-swagger/ResponseFactory.hpp"
+
 #include "oatpp/data/resource/File.hpp"
 #include "oatpp/data/resource/InMemoryData.hpp"
 #include "oatpp/base/Log.hpp"
 
-#include <fstream>
+#include <filesystem>
+#include <string>
 
 namespace oatpp { namespace swagger {
   
@@ -66,6 +69,7 @@ void Resources::addResource(const oatpp::String& fileName) {
 
   if(m_streaming) {
     m_resources[fileName] = std::make_shared<data::resource::File>(m_resDir, fileName);
+    m_filePaths[fileName] = *data::resource::File::concatDirAndName(m_resDir, fileName);
   } else {
     auto path = data::resource::File::concatDirAndName(m_resDir, fileName);
     auto data = oatpp::String::loadFromFile(path->c_str());
@@ -74,11 +78,19 @@ void Resources::addResource(const oatpp::String& fileName) {
       throw std::runtime_error("[oatpp::swagger::Resources::addResource()]: Can't load file. Please make sure you specified full path to oatpp-swagger/res folder");
     }
     m_resources[fileName] = std::make_shared<data::resource::InMemoryData>(data);
+    m_etags[fileName] = ResponseFactory::createETag(data->data(), static_cast<v_buff_size>(data->size()));
   }
 }
 
 void Resources::overrideResource(const oatpp::String& filename, const std::shared_ptr<data::resource::Resource>& resource) {
   m_resources[filename] = resource;
+  m_filePaths.erase(filename);
+  auto data = resource->getInMemoryData();
+  if(data) {
+    m_etags[filename] = ResponseFactory::createETag(data->data(), static_cast<v_buff_size>(data->size()));
+  } else {
+    m_etags.erase(filename);
+  }
 }
 
 std::shared_ptr<data::resource::Resource> Resources::getResource(const oatpp::String& filename) const {
@@ -94,6 +106,67 @@ std::shared_ptr<data::resource::Resource> Resources::getResource(const oatpp::St
                            "3. You specified correct full path to oatpp-swagger/res folder");
 }
 
+std::shared_ptr<data::resource::Resource> Resources::findResource(const oatpp::String& filename) const {
+  auto it = m_resources.find(filename);
+  if(it != m_resources.end()) {
+    return it->second;
+  }
+  return nullptr;
+}
+
+std::vector<oatpp::String> Resources::getResourceNames() const {
+  std::vector<oatpp::String> result;
+  result.reserve(m_resources.size());
+  for(auto& pair : m_resources) {
+    result.push_back(pair.first);
+  }
+  return result;
+}
+
+Resources::ResourceInfo Resources::getResourceInfo(const oatpp::String& filename) const {
+
+  ResourceInfo info {-1, nullptr};
+
+  auto it = m_resources.find(filename);
+  if(it == m_resources.end()) {
+    return info;
+  }
+
+  auto pathIt = m_filePaths.find(filename);
+  if(pathIt != m_filePaths.end()) {
+    // The file may change while the server is running - take its status now.
+    std::error_code ec;
+    auto size = std::filesystem::file_size(pathIt->second, ec);
+    if(ec) {
+      return info;
+    }
+    auto mtime = std::filesystem::last_write_time(pathIt->second, ec);
+    if(ec) {
+      return info;
+    }
+    info.size = static_cast<v_int64>(size);
+    auto key = std::to_string(size) + "-" + std::to_string(mtime.time_since_epoch().count());
+    info.etag = ResponseFactory::createETag(key.data(), static_cast<v_buff_size>(key.size()));
+    return info;
+  }
+
+  info.size = it->second->getKnownSize();
+  auto etagIt = m_etags.find(filename);
+  if(etagIt != m_etags.end()) {
+    info.etag = etagIt->second;
+  }
+  return info;
+
+}
+
+v_int64 Resources::getResourceSize(const oatpp::String& filename) const {
+  return getResourceInfo(filename).size;
+}
+
+oatpp::String Resources::getResourceETag(const oatpp::String& filename) const {
+  return getResourceInfo(filename).etag;
+}
+
 oatpp::String Resources::getResourceData(const oatpp::String& filename) const {
   auto resource = getResource(filename);
   if(resource->getInMemoryData() && resource->getKnownSize() > 0) {
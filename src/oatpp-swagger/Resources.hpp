@@ -31,6 +31,7 @@
 #include "oatpp/data/resource/Resource.hpp"
 
 #include <unordered_map>
+#include <vector>
 
 namespace oatpp { namespace swagger {
 
@@ -38,10 +39,31 @@ namespace oatpp { namespace swagger {
  * This class is responsible for loading Swagger-UI resources.
  */
 class Resources {
+public:
+
+  /**
+   * Size and ETag of the resource taken at the same moment.
+   */
+  struct ResourceInfo {
+
+    /**
+     * Size of the resource in bytes. `-1` if unknown.
+     */
+    v_int64 size;
+
+    /**
+     * Quoted ETag of the resource. `nullptr` if unknown.
+     */
+    oatpp::String etag;
+
+  };
+
 private:
   oatpp::String m_resDir;
   bool m_streaming;
   std::unordered_map<oatpp::String, std::shared_ptr<data::resource::Resource>> m_resources;
+  std::unordered_map<oatpp::String, std::string> m_filePaths;
+  std::unordered_map<oatpp::String, oatpp::String> m_etags;
 private:
   void addResource(const oatpp::String& fileName);
   bool hasEnding(std::string fullString, std::string const &ending) const;
@@ -78,6 +100,42 @@ public:
    */
   std::shared_ptr<data::resource::Resource> getResource(const oatpp::String& filename) const;
 
+  /**
+   * Find resource by filename. Unlike &l:Resources::getResource (); doesn't throw.
+   * @param filename - name of the resource file.
+   * @return - &id:oatpp::data::resource::Resource; or `nullptr` if not found.
+   */
+  std::shared_ptr<data::resource::Resource> findResource(const oatpp::String& filename) const;
+
+  /**
+   * Get names of all resources.
+   * @return
+   */
+  std::vector<oatpp::String> getResourceNames() const;
+
+  /**
+   * Get size and ETag of the resource. <br>
+   * For streamed files both are taken from the file status at the time of the call - ETag is derived from the size and
+   * the modification time, so the file is never read to compute it. For in-memory resources ETag is computed from the content once.
+   * @param filename - name of the resource file.
+   * @return - &l:Resources::ResourceInfo;.
+   */
+  ResourceInfo getResourceInfo(const oatpp::String& filename) const;
+
+  /**
+   * Get size of the resource in bytes. See &l:Resources::getResourceInfo ();.
+   * @param filename - name of the resource file.
+   * @return - size of the resource or `-1` if unknown.
+   */
+  v_int64 getResourceSize(const oatpp::String& filename) const;
+
+  /**
+   * Get ETag of the resource. See &l:Resources::getResourceInfo ();.
+   * @param filename - name of the resource file.
+   * @return - quoted ETag or `nullptr` if unknown.
+   */
+  oatpp::String getResourceETag(const oatpp::String& filename) const;
+
   /**
    * Get resource data.
    * @param filename
@@ -0,0 +1,401 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi, <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "ResponseFactory.hpp"
+
+#include "oatpp-swagger/ResourceBody.hpp"
+
+#include "oatpp/web/protocol/http/outgoing/StreamingBody.hpp"
+
+#include <cstdio>
+#include <limits>
+#include <string>
+
+namespace oatpp { namespace swagger {
+
+namespace {
+
+  typedef oatpp::web::protocol::http::Status Status;
+
+  const v_uint64 FNV_OFFSET_BASIS = 14695981039346656037ULL;
+  const v_uint64 FNV_PRIME = 1099511628211ULL;
+
+  v_uint64 fnv1a(v_uint64 hash, const char* data, v_buff_size size) {
+    for(v_buff_size i = 0; i < size; i++) {
+      hash ^= static_cast<v_uint8>(data[i]);
+      hash *= FNV_PRIME;
+    }
+    return hash;
+  }
+
+  oatpp::String formatETag(v_uint64 hash) {
+    char buffer[24];
+    std::snprintf(buffer, sizeof(buffer), "\"%016llx\"", static_cast<unsigned long long>(hash));
+    return oatpp::String(buffer);
+  }
+
+  /*
+   * Body of the response to `HEAD` request and of `304` - declares the size of the content, but has nothing to read.
+   */
+  class HeadBody : public oatpp::web::protocol::http::outgoing::Body {
+  private:
+    v_int64 m_size;
+  public:
+
+    HeadBody(v_int64 size)
+      : m_size(size)
+    {}
+
+    v_io_size read(void *buffer, v_buff_size count, async::Action& action) override {
+      (void) buffer;
+      (void) count;
+      (void) action;
+      return 0;
+    }
+
+    void declareHeaders(Headers& headers) override {
+      (void) headers;
+    }
+
+    p_char8 getKnownData() override {
+      return nullptr;
+    }
+
+    v_int64 getKnownSize() override {
+      return m_size;
+    }
+
+  };
+
+  std::string trim(const std::string& str) {
+    auto first = str.find_first_not_of(" \t");
+    if(first == std::string::npos) {
+      return "";
+    }
+    auto last = str.find_last_not_of(" \t");
+    return str.substr(first, last - first + 1);
+  }
+
+  /*
+   * Parse non-negative decimal number. Returns false on empty input, non-digit characters or overflow.
+   */
+  bool parseNumber(const std::string& str, v_int64& result) {
+    if(str.empty()) {
+      return false;
+    }
+    result = 0;
+    for(char c : str) {
+      if(c < '0' || c > '9') {
+        return false;
+      }
+      if(result > (std::numeric_limits<v_int64>::max() - (c - '0')) / 10) {
+        return false;
+      }
+      result = result * 10 + (c - '0');
+    }
+    return true;
+  }
+
+}
+
+oatpp::String ResponseFactory::getHeader(const std::shared_ptr<IncomingRequest>& request, const char* name) {
+  if(!request) {
+    return nullptr;
+  }
+  return request->getHeader(name);
+}
+
+bool ResponseFactory::matchesETag(const oatpp::String& header, const oatpp::String& etag) {
+
+  std::string value = header;
+  if(trim(value) == "*") {
+    return true;
+  }
+
+  size_t begin = 0;
+  while(begin <= value.size()) {
+    auto end = value.find(',', begin);
+    if(end == std::string::npos) {
+      end = value.size();
+    }
+    auto candidate = trim(value.substr(begin, end - begin));
+    // If-None-Match uses the weak comparison
+    if(candidate.size() > 2 && candidate[0] == 'W' && candidate[1] == '/') {
+      candidate = candidate.substr(2);
+    }
+    if(candidate == *etag) {
+      return true;
+    }
+    begin = end + 1;
+  }
+
+  return false;
+
+}
+
+ResponseFactory::RangeResult ResponseFactory::parseRange(const oatpp::String& header, v_int64 size, ByteRange& range) {
+
+  static const std::string UNIT = "bytes=";
+
+  std::string value = trim(header);
+  if(value.compare(0, UNIT.size(), UNIT) != 0) {
+    return RangeResult::NONE;
+  }
+
+  auto spec = trim(value.substr(UNIT.size()));
+  if(spec.find(',') != std::string::npos) {
+    return RangeResult::NONE;
+  }
+
+  auto dash = spec.find('-');
+  if(dash == std::string::npos) {
+    return RangeResult::NONE;
+  }
+
+  auto firstStr = trim(spec.substr(0, dash));
+  auto lastStr = trim(spec.substr(dash + 1));
+
+  if(firstStr.empty()) {
+    // suffix range - last N bytes
+    v_int64 suffix;
+    if(!parseNumber(lastStr, suffix)) {
+      return RangeResult::NONE;
+    }
+    if(suffix == 0 || size == 0) {
+      return RangeResult::UNSATISFIABLE;
+    }
+    range.first = suffix >= size ? 0 : size - suffix;
+    range.last = size - 1;
+    return RangeResult::SATISFIABLE;
+  }
+
+  v_int64 first;
+  if(!parseNumber(firstStr, first)) {
+    return RangeResult::NONE;
+  }
+
+  v_int64 last = size - 1;
+  if(!lastStr.empty()) {
+    if(!parseNumber(lastStr, last)) {
+      return RangeResult::NONE;
+    }
+    if(last < first) {
+      return RangeResult::NONE;
+    }
+  }
+
+  if(first >= size) {
+    return RangeResult::UNSATISFIABLE;
+  }
+
+  range.first = first;
+  range.last = last < size ? last : size - 1;
+  return RangeResult::SATISFIABLE;
+
+}
+
+oatpp::String ResponseFactory::createETag(const char* data, v_buff_size size) {
+  return formatETag(fnv1a(FNV_OFFSET_BASIS, data, size));
+}
+
+void ResponseFactory::disableContentEncoding(const std::shared_ptr<IncomingRequest>& request) {
+  // The server picks the content encoder by the request's Accept-Encoding after the endpoint returns.
+  if(request) {
+    request->putOrReplaceHeader("Accept-Encoding", "identity");
+  }
+}
+
+std::shared_ptr<ResponseFactory::OutgoingResponse> ResponseFactory::createNotModifiedResponse(const std::shared_ptr<IncomingRequest>& request,
+                                                                                              v_int64 size,
+                                                                                              const oatpp::String& etag)
+{
+  // oatpp always frames the response with Content-Length or chunked encoding, and 304 has no content.
+  // Declare the size of the content which would be sent with 200 - the only Content-Length allowed in 304 - and send nothing.
+  if(etag && size >= 0) {
+    auto ifNoneMatch = getHeader(request, "If-None-Match");
+    if(ifNoneMatch && matchesETag(ifNoneMatch, etag)) {
+      disableContentEncoding(request);
+      auto response = OutgoingResponse::createShared(Status::CODE_304, std::make_shared<HeadBody>(size));
+      response->putHeader("ETag", etag);
+      return response;
+    }
+  }
+  return nullptr;
+}
+
+void ResponseFactory::putContentHeaders(const std::shared_ptr<OutgoingResponse>& response,
+                                        v_int64 size,
+                                        const oatpp::String& etag,
+                                        const oatpp::String& contentType)
+{
+  if(size >= 0) {
+    response->putHeader("Accept-Ranges", "bytes");
+  }
+  if(etag) {
+    response->putHeader("ETag", etag);
+  }
+  if(contentType) {
+    response->putHeader("Content-Type", contentType);
+  }
+}
+
+ResponseFactory::Content ResponseFactory::createContent(const oatpp::String& data, const oatpp::String& contentType) {
+  Content content;
+  content.data = data;
+  content.etag = createETag(data->data(), static_cast<v_buff_size>(data->size()));
+  content.contentType = contentType;
+  return content;
+}
+
+std::shared_ptr<ResponseFactory::OutgoingResponse> ResponseFactory::createResponse(const std::shared_ptr<IncomingRequest>& request,
+                                                                                   v_int64 size,
+                                                                                   const oatpp::String& etag,
+                                                                                   const oatpp::String& contentType,
+                                                                                   const BodyProvider& bodyProvider)
+{
+
+  auto response = createNotModifiedResponse(request, size, etag);
+  if(response) {
+    return response;
+  }
+
+  if(size >= 0) {
+
+    auto rangeHeader = getHeader(request, "Range");
+    if(rangeHeader) {
+
+      // If-Range - serve the range only if the client has the current version of the content (strong comparison)
+      auto ifRange = getHeader(request, "If-Range");
+      bool rangeAllowed = !ifRange || (etag && ifRange == etag);
+
+      ByteRange range;
+      auto result = rangeAllowed ? parseRange(rangeHeader, size, range) : RangeResult::NONE;
+
+      if(result == RangeResult::SATISFIABLE) {
+        // Content-Range refers to the bytes of the unencoded content.
+        disableContentEncoding(request);
+        auto length = range.last - range.first + 1;
+        response = OutgoingResponse::createShared(Status::CODE_206, bodyProvider(range.first, length));
+        response->putHeader("Content-Range", "bytes " + std::to_string(range.first) + "-" + std::to_string(range.last) + "/" + std::to_string(size));
+      } else if(result == RangeResult::UNSATISFIABLE) {
+        response = OutgoingResponse::createShared(Status::CODE_416, std::make_shared<ResourceBody>(oatpp::String("")));
+        response->putHeader("Content-Range", "bytes */" + std::to_string(size));
+        return response;
+      }
+
+    }
+
+  }
+
+  if(!response) {
+    response = OutgoingResponse::createShared(Status::CODE_200, bodyProvider(0, -1));
+  }
+
+  putContentHeaders(response, size, etag, contentType);
+
+  return response;
+
+}
+
+std::shared_ptr<ResponseFactory::OutgoingResponse> ResponseFactory::createContentResponse(const std::shared_ptr<IncomingRequest>& request,
+                                                                                          const Content& content)
+{
+  auto response = createDataResponse(request, content.data, content.etag, content.contentType);
+  if(response->getStatus().code != Status::CODE_304.code) {
+    for(const auto& header : content.headers) {
+      response->putHeader(header.first, header.second);
+    }
+  }
+  return response;
+}
+
+std::shared_ptr<ResponseFactory::OutgoingResponse> ResponseFactory::createContentHeadResponse(const std::shared_ptr<IncomingRequest>& request,
+                                                                                              const Content& content)
+{
+  auto response = createHeadResponse(request, static_cast<v_int64>(content.data->size()), content.etag, content.contentType);
+  if(response->getStatus().code != Status::CODE_304.code) {
+    for(const auto& header : content.headers) {
+      response->putHeader(header.first, header.second);
+    }
+  }
+  return response;
+}
+
+std::shared_ptr<ResponseFactory::OutgoingResponse> ResponseFactory::createHeadResponse(const std::shared_ptr<IncomingRequest>& request,
+                                                                                       v_int64 size,
+                                                                                       const oatpp::String& etag,
+                                                                                       const oatpp::String& contentType)
+{
+
+  auto response = createNotModifiedResponse(request, size, etag);
+  if(response) {
+    return response;
+  }
+
+  // Content-Length of the response to HEAD is the one of the unencoded content.
+  disableContentEncoding(request);
+
+  if(size >= 0) {
+    response = OutgoingResponse::createShared(Status::CODE_200, std::make_shared<HeadBody>(size));
+  } else {
+    // Size is unknown. Chunked framing would make the server write a terminating chunk, so declare an empty body instead.
+    response = OutgoingResponse::createShared(Status::CODE_200, std::make_shared<ResourceBody>(oatpp::String("")));
+  }
+
+  putContentHeaders(response, size, etag, contentType);
+
+  return response;
+
+}
+
+std::shared_ptr<ResponseFactory::OutgoingResponse> ResponseFactory::createDataResponse(const std::shared_ptr<IncomingRequest>& request,
+                                                                                       const oatpp::String& data,
+                                                                                       const oatpp::String& etag,
+                                                                                       const oatpp::String& contentType)
+{
+  return createResponse(request, static_cast<v_int64>(data->size()), etag, contentType, [&data](v_int64 offset, v_int64 length) {
+    return std::make_shared<ResourceBody>(data, offset, length);
+  });
+}
+
+std::shared_ptr<ResponseFactory::OutgoingResponse> ResponseFactory::createResourceResponse(const std::shared_ptr<IncomingRequest>& request,
+                                                                                           const std::shared_ptr<data::resource::Resource>& resource,
+                                                                                           v_int64 size,
+                                                                                           const oatpp::String& etag,
+                                                                                           const oatpp::String& contentType)
+{
+  return createResponse(request, size, etag, contentType, [&resource, size](v_int64 offset, v_int64 length) {
+    return ResourceBody::createShared(resource, size, offset, length);
+  });
+}
+
+std::shared_ptr<ResponseFactory::OutgoingResponse> ResponseFactory::createEventStreamResponse(const std::shared_ptr<data::stream::ReadCallback>& stream) {
+  auto response = OutgoingResponse::createShared(Status::CODE_200, std::make_shared<web::protocol::http::outgoing::StreamingBody>(stream));
+  response->putHeader("Content-Type", "text/event-stream");
+  response->putHeader("Cache-Control", "no-cache");
+  return response;
+}
+
+}}
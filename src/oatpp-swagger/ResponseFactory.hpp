@@ -0,0 +1,242 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi, <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef oatpp_swagger_ResponseFactory_hpp
+#define oatpp_swagger_ResponseFactory_hpp
+
+#include "oatpp/web/protocol/http/incoming/Request.hpp"
+#include "oatpp/web/protocol/http/outgoing/Response.hpp"
+#include "oatpp/data/resource/Resource.hpp"
+#include "oatpp/Types.hpp"
+
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace oatpp { namespace swagger {
+
+/**
+ * Creates responses for static content (UI resources and the API document) shared by
+ * &id:oatpp::swagger::Controller; and &id:oatpp::swagger::AsyncController;. <br>
+ * Handles:
+ * <ul>
+ *   <li>`ETag` and `If-None-Match` - `304 Not Modified`.</li>
+ *   <li>`Range` and `If-Range` - `206 Partial Content` for a single byte range, `416 Range Not Satisfiable` for unsatisfiable ranges.
+ *   Requests for multiple ranges are answered with the full content.</li>
+ *   <li>`206`, `304` and `HEAD` responses are never content-encoded - their framing refers to the unencoded content.</li>
+ * </ul>
+ */
+class ResponseFactory {
+public:
+  typedef oatpp::web::protocol::http::incoming::Request IncomingRequest;
+  typedef oatpp::web::protocol::http::outgoing::Response OutgoingResponse;
+  typedef oatpp::web::protocol::http::outgoing::Body Body;
+public:
+
+  /**
+   * Byte range. Both `first` and `last` are inclusive.
+   */
+  struct ByteRange {
+    v_int64 first;
+    v_int64 last;
+  };
+
+  /**
+   * Result of the `Range` header parsing.
+   */
+  enum class RangeResult : v_int32 {
+
+    /**
+     * No range, or range which should be ignored (unsupported unit, multiple ranges, malformed header). Full content should be served.
+     */
+    NONE = 0,
+
+    /**
+     * Valid satisfiable single range.
+     */
+    SATISFIABLE = 1,
+
+    /**
+     * Range can't be satisfied for the content of the given size.
+     */
+    UNSATISFIABLE = 2
+
+  };
+
+  /**
+   * Function creating body for the given byte range - `(offset, length)`.
+   */
+  typedef std::function<std::shared_ptr<Body>(v_int64, v_int64)> BodyProvider;
+
+  /**
+   * In-memory content rendered once together with its metadata.
+   */
+  struct Content {
+
+    /**
+     * Content data.
+     */
+    oatpp::String data;
+
+    /**
+     * Quoted ETag of the data.
+     */
+    oatpp::String etag;
+
+    /**
+     * Value of the `Content-Type` header.
+     */
+    oatpp::String contentType;
+
+    /**
+     * Additional headers of the response (ex.: `Link`).
+     */
+    std::vector<std::pair<oatpp::String, oatpp::String>> headers;
+
+  };
+
+private:
+  static oatpp::String getHeader(const std::shared_ptr<IncomingRequest>& request, const char* name);
+  static bool matchesETag(const oatpp::String& header, const oatpp::String& etag);
+  static void disableContentEncoding(const std::shared_ptr<IncomingRequest>& request);
+  static std::shared_ptr<OutgoingResponse> createNotModifiedResponse(const std::shared_ptr<IncomingRequest>& request,
+                                                                     v_int64 size,
+                                                                     const oatpp::String& etag);
+  static void putContentHeaders(const std::shared_ptr<OutgoingResponse>& response,
+                                v_int64 size,
+                                const oatpp::String& etag,
+                                const oatpp::String& contentType);
+public:
+
+  /**
+   * Parse value of the `Range` header. Only the `bytes` unit with a single range is supported.
+   * @param header - value of the `Range` header.
+   * @param size - size of the content.
+   * @param range - &l:ResponseFactory::ByteRange;. Set if &l:ResponseFactory::RangeResult::SATISFIABLE; is returned.
+   * @return - &l:ResponseFactory::RangeResult;.
+   */
+  static RangeResult parseRange(const oatpp::String& header, v_int64 size, ByteRange& range);
+
+  /**
+   * Create strong ETag from the content.
+   * @param data - pointer to data.
+   * @param size - size of data.
+   * @return - quoted ETag.
+   */
+  static oatpp::String createETag(const char* data, v_buff_size size);
+
+  /**
+   * Create &l:ResponseFactory::Content;. ETag is computed from the data.
+   * @param data - content data.
+   * @param contentType - value of the `Content-Type` header.
+   * @return - &l:ResponseFactory::Content;.
+   */
+  static Content createContent(const oatpp::String& data, const oatpp::String& contentType);
+
+  /**
+   * Create response for the content of a known size.
+   * @param request - incoming request. May be `nullptr` - then the full content is served.
+   * @param size - size of the content. If `< 0` - ranges are not supported and the full content is served.
+   * @param etag - ETag of the content. May be `nullptr`.
+   * @param contentType - value of the `Content-Type` header.
+   * @param bodyProvider - &l:ResponseFactory::BodyProvider;.
+   * @return - &id:oatpp::web::protocol::http::outgoing::Response;.
+   */
+  static std::shared_ptr<OutgoingResponse> createResponse(const std::shared_ptr<IncomingRequest>& request,
+                                                          v_int64 size,
+                                                          const oatpp::String& etag,
+                                                          const oatpp::String& contentType,
+                                                          const BodyProvider& bodyProvider);
+
+  /**
+   * Create response for the in-memory data.
+   * @param request - incoming request. May be `nullptr`.
+   * @param data - data.
+   * @param etag - ETag of the data. May be `nullptr`.
+   * @param contentType - value of the `Content-Type` header.
+   * @return - &id:oatpp::web::protocol::http::outgoing::Response;.
+   */
+  static std::shared_ptr<OutgoingResponse> createDataResponse(const std::shared_ptr<IncomingRequest>& request,
+                                                              const oatpp::String& data,
+                                                              const oatpp::String& etag,
+                                                              const oatpp::String& contentType);
+
+  /**
+   * Create response for the &l:ResponseFactory::Content;.
+   * @param request - incoming request. May be `nullptr`.
+   * @param content - &l:ResponseFactory::Content;.
+   * @return - &id:oatpp::web::protocol::http::outgoing::Response;.
+   */
+  static std::shared_ptr<OutgoingResponse> createContentResponse(const std::shared_ptr<IncomingRequest>& request, const Content& content);
+
+  /**
+   * Create response to the `HEAD` request for the &l:ResponseFactory::Content;.
+   * @param request - incoming request. May be `nullptr`.
+   * @param content - &l:ResponseFactory::Content;.
+   * @return - &id:oatpp::web::protocol::http::outgoing::Response;.
+   */
+  static std::shared_ptr<OutgoingResponse> createContentHeadResponse(const std::shared_ptr<IncomingRequest>& request, const Content& content);
+
+  /**
+   * Create response to the `HEAD` request. <br>
+   * Response carries the same headers as the response to `GET` (including `Content-Length`), but no body is read or sent.
+   * @param request - incoming request. May be `nullptr`.
+   * @param size - size of the content. `-1` if unknown.
+   * @param etag - ETag of the content. May be `nullptr`.
+   * @param contentType - value of the `Content-Type` header.
+   * @return - &id:oatpp::web::protocol::http::outgoing::Response;.
+   */
+  static std::shared_ptr<OutgoingResponse> createHeadResponse(const std::shared_ptr<IncomingRequest>& request,
+                                                              v_int64 size,
+                                                              const oatpp::String& etag,
+                                                              const oatpp::String& contentType);
+
+  /**
+   * Create response for the resource.
+   * @param request - incoming request. May be `nullptr`.
+   * @param resource - &id:oatpp::data::resource::Resource;.
+   * @param size - size of the resource. `-1` if unknown.
+   * @param etag - ETag of the resource. May be `nullptr`.
+   * @param contentType - value of the `Content-Type` header.
+   * @return - &id:oatpp::web::protocol::http::outgoing::Response;.
+   */
+  static std::shared_ptr<OutgoingResponse> createResourceResponse(const std::shared_ptr<IncomingRequest>& request,
+                                                                  const std::shared_ptr<data::resource::Resource>& resource,
+                                                                  v_int64 size,
+                                                                  const oatpp::String& etag,
+                                                                  const oatpp::String& contentType);
+
+  /**
+   * Create `text/event-stream` response. The body is sent with the chunked transfer encoding and is never cached.
+   * @param stream - &id:oatpp::data::stream::ReadCallback; producing the events.
+   * @return - &id:oatpp::web::protocol::http::outgoing::Response;.
+   */
+  static std::shared_ptr<OutgoingResponse> createEventStreamResponse(const std::shared_ptr<data::stream::ReadCallback>& stream);
+
+};
+
+}}
+
+#endif // oatpp_swagger_ResponseFactory_hpp
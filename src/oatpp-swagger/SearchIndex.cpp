@@ -0,0 +1,299 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi, <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "SearchIndex.hpp"
+
+#include "oatpp-swagger/DocumentFragments.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <map>
+#include <unordered_map>
+
+namespace oatpp { namespace swagger {
+
+namespace {
+
+  constexpr v_int32 WEIGHT_OPERATION_ID = 8;
+  constexpr v_int32 WEIGHT_SCHEMA_NAME = 8;
+  constexpr v_int32 WEIGHT_PATH = 6;
+  constexpr v_int32 WEIGHT_TAG = 4;
+  constexpr v_int32 WEIGHT_SUMMARY = 3;
+  constexpr v_int32 WEIGHT_DESCRIPTION = 1;
+
+  typedef std::map<std::string, std::unordered_map<v_uint32, v_int32>> TermsBuilder;
+
+  void addText(TermsBuilder& terms, v_uint32 entry, const oatpp::String& text, v_int32 weight) {
+    if(!text) {
+      return;
+    }
+    for(auto& term : SearchIndex::tokenize(*text, true)) {
+      auto& w = terms[term][entry];
+      w = std::max(w, weight);
+    }
+  }
+
+}
+
+SearchIndex::SearchIndex(const oatpp::Object<oas3::Document>& document) {
+
+  TermsBuilder terms;
+
+  if(document->paths) {
+    for(auto& path : *document->paths) {
+
+      const auto& item = path.second;
+      const std::pair<const char*, oatpp::Object<oas3::PathItemOperation>> operations[] = {
+        {"GET", item->operationGet},
+        {"PUT", item->operationPut},
+        {"POST", item->operationPost},
+        {"DELETE", item->operationDelete},
+        {"OPTIONS", item->operationOptions},
+        {"HEAD", item->operationHead},
+        {"PATCH", item->operationPatch},
+        {"TRACE", item->operationTrace}
+      };
+
+      for(auto& operation : operations) {
+
+        if(!operation.second) {
+          continue;
+        }
+
+        std::string method = operation.first;
+        std::transform(method.begin(), method.end(), method.begin(), [](unsigned char c) { return std::tolower(c); });
+
+        auto index = static_cast<v_uint32>(m_entries.size());
+
+        Entry entry;
+        entry.pointer = "/paths/" + DocumentFragments::escapeToken(*path.first) + "/" + method;
+        entry.kind = "operation";
+        entry.method = operation.first;
+        entry.path = path.first;
+        entry.operationId = operation.second->operationId;
+        entry.summary = operation.second->summary;
+        m_entries.push_back(entry);
+
+        addText(terms, index, operation.second->operationId, WEIGHT_OPERATION_ID);
+        addText(terms, index, path.first, WEIGHT_PATH);
+        addText(terms, index, operation.second->summary, WEIGHT_SUMMARY);
+        addText(terms, index, operation.second->description, WEIGHT_DESCRIPTION);
+        if(operation.second->tags) {
+          for(auto& tag : *operation.second->tags) {
+            addText(terms, index, tag, WEIGHT_TAG);
+          }
+        }
+
+      }
+
+    }
+  }
+
+  if(document->components && document->components->schemas) {
+    for(auto& schema : *document->components->schemas) {
+
+      auto index = static_cast<v_uint32>(m_entries.size());
+
+      Entry entry;
+      entry.pointer = "/components/schemas/" + DocumentFragments::escapeToken(*schema.first);
+      entry.kind = "schema";
+      entry.name = schema.first;
+      m_entries.push_back(entry);
+
+      addText(terms, index, schema.first, WEIGHT_SCHEMA_NAME);
+      if(schema.second) {
+        addText(terms, index, schema.second->description, WEIGHT_DESCRIPTION);
+      }
+
+    }
+  }
+
+  m_terms.reserve(terms.size());
+  for(auto& term : terms) {
+    std::vector<Posting> postings;
+    postings.reserve(term.second.size());
+    for(auto& p : term.second) {
+      postings.push_back({p.first, p.second});
+    }
+    std::sort(postings.begin(), postings.end(), [](const Posting& a, const Posting& b) {
+      return a.entry < b.entry;
+    });
+    m_terms.emplace_back(term.first, std::move(postings));
+  }
+
+}
+
+std::vector<std::string> SearchIndex::tokenize(const std::string& text, bool compound) {
+
+  std::vector<std::string> result;
+
+  std::string word;
+  std::string part;
+  bool split = false;
+
+  auto flushPart = [&] {
+    if(!part.empty()) {
+      result.push_back(part);
+      part.clear();
+    }
+  };
+
+  auto flushWord = [&] {
+    flushPart();
+    if(compound && split && !word.empty()) {
+      result.push_back(word);
+    }
+    word.clear();
+    split = false;
+  };
+
+  for(size_t i = 0; i < text.size(); i++) {
+
+    auto c = static_cast<unsigned char>(text[i]);
+
+    if(!std::isalnum(c)) {
+      flushWord();
+      continue;
+    }
+
+    if(std::isupper(c) && !part.empty()) {
+      bool prevLower = std::islower(static_cast<unsigned char>(text[i - 1])) || std::isdigit(static_cast<unsigned char>(text[i - 1]));
+      bool nextLower = i + 1 < text.size() && std::islower(static_cast<unsigned char>(text[i + 1]));
+      // "userId" -> "user", "id"; "HTTPServer" -> "http", "server"
+      if(prevLower || (nextLower && std::isupper(static_cast<unsigned char>(text[i - 1])))) {
+        flushPart();
+        split = true;
+      }
+    }
+
+    auto lower = static_cast<char>(std::tolower(c));
+    part.push_back(lower);
+    word.push_back(lower);
+
+  }
+
+  flushWord();
+
+  return result;
+
+}
+
+oatpp::List<oatpp::Object<SearchResult>> SearchIndex::search(const oatpp::String& query, v_int32 limit) const {
+
+  auto result = oatpp::List<oatpp::Object<SearchResult>>::createShared();
+
+  if(!query || limit <= 0) {
+    return result;
+  }
+  limit = std::min(limit, MAX_LIMIT);
+
+  auto queryTerms = tokenize(*query, false);
+  std::sort(queryTerms.begin(), queryTerms.end());
+  queryTerms.erase(std::unique(queryTerms.begin(), queryTerms.end()), queryTerms.end());
+  if(queryTerms.size() > MAX_QUERY_TERMS) {
+    queryTerms.resize(MAX_QUERY_TERMS);
+  }
+
+  if(queryTerms.empty()) {
+    return result;
+  }
+
+  struct Score {
+    v_int32 score = 0;
+    v_uint32 matched = 0;
+  };
+
+  std::unordered_map<v_uint32, Score> scores;
+
+  for(v_uint32 q = 0; q < queryTerms.size(); q++) {
+
+    const auto& queryTerm = queryTerms[q];
+
+    // best score of each entry for this query term
+    std::unordered_map<v_uint32, v_int32> termScores;
+
+    auto it = std::lower_bound(m_terms.begin(), m_terms.end(), queryTerm, [](const Term& term, const std::string& value) {
+      return term.first < value;
+    });
+
+    for(; it != m_terms.end() && it->first.compare(0, queryTerm.size(), queryTerm) == 0; it++) {
+      v_int32 factor = it->first.size() == queryTerm.size() ? 2 : 1;
+      for(auto& posting : it->second) {
+        auto& s = termScores[posting.entry];
+        s = std::max(s, posting.weight * factor);
+      }
+    }
+
+    for(auto& termScore : termScores) {
+      auto& s = scores[termScore.first];
+      s.score += termScore.second;
+      s.matched |= (1u << q);
+    }
+
+  }
+
+  v_uint32 allMatched = (1u << queryTerms.size()) - 1;
+
+  std::vector<std::pair<v_uint32, v_int32>> ranked;
+  for(auto& s : scores) {
+    if(s.second.matched == allMatched) {
+      ranked.push_back({s.first, s.second.score});
+    }
+  }
+
+  std::sort(ranked.begin(), ranked.end(), [](const std::pair<v_uint32, v_int32>& a, const std::pair<v_uint32, v_int32>& b) {
+    if(a.second != b.second) {
+      return a.second > b.second;
+    }
+    return a.first < b.first;
+  });
+
+  if(ranked.size() > static_cast<size_t>(limit)) {
+    ranked.resize(static_cast<size_t>(limit));
+  }
+
+  for(auto& r : ranked) {
+    const auto& entry = m_entries[r.first];
+    auto dto = SearchResult::createShared();
+    dto->pointer = entry.pointer;
+    dto->kind = entry.kind;
+    dto->score = r.second;
+    dto->method = entry.method;
+    dto->path = entry.path;
+    dto->operationId = entry.operationId;
+    dto->summary = entry.summary;
+    dto->name = entry.name;
+    result->push_back(dto);
+  }
+
+  return result;
+
+}
+
+v_int64 SearchIndex::getTermsCount() const {
+  return static_cast<v_int64>(m_terms.size());
+}
+
+}}
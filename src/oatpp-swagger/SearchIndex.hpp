@@ -0,0 +1,176 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi, <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef oatpp_swagger_SearchIndex_hpp
+#define oatpp_swagger_SearchIndex_hpp
+
+#include "oatpp-swagger/oas3/Model.hpp"
+
+#include "oatpp/macro/codegen.hpp"
+
+#include <string>
+#include <vector>
+
+namespace oatpp { namespace swagger {
+
+#include OATPP_CODEGEN_BEGIN(DTO)
+
+/**
+ * Search result of the &l:SearchIndex;.
+ */
+class SearchResult : public oatpp::DTO {
+
+  DTO_INIT(SearchResult, DTO)
+
+  /**
+   * JSON Pointer to the matched node of the document. Ex.: `/paths/~1users~1{id}/get`, `/components/schemas/UserDto`.
+   */
+  DTO_FIELD(String, pointer);
+
+  /**
+   * Kind of the matched node - `operation` or `schema`.
+   */
+  DTO_FIELD(String, kind);
+
+  /**
+   * Relevance score. Results are sorted by score in descending order.
+   */
+  DTO_FIELD(Int32, score);
+
+  /**
+   * HTTP method in upper case. Operations only.
+   */
+  DTO_FIELD(String, method);
+
+  /**
+   * Path. Operations only.
+   */
+  DTO_FIELD(String, path);
+
+  /**
+   * Operation ID. Operations only.
+   */
+  DTO_FIELD(String, operationId);
+
+  /**
+   * Summary. Operations only.
+   */
+  DTO_FIELD(String, summary);
+
+  /**
+   * Schema name. Schemas only.
+   */
+  DTO_FIELD(String, name);
+
+};
+
+#include OATPP_CODEGEN_END(DTO)
+
+/**
+ * In-memory inverted index over operations and component schemas of the API document. <br>
+ * Indexes operationIds, paths, summaries, descriptions, tags and schema names.
+ * Built once when the document is generated, read-only afterwards.
+ */
+class SearchIndex {
+public:
+
+  /**
+   * Max number of terms in the query. Extra terms are ignored.
+   */
+  static constexpr v_uint32 MAX_QUERY_TERMS = 16;
+
+  /**
+   * Max length of the query in bytes.
+   */
+  static constexpr v_buff_size MAX_QUERY_SIZE = 1024;
+
+  /**
+   * Default max number of results returned by one search.
+   */
+  static constexpr v_int32 DEFAULT_LIMIT = 20;
+
+  /**
+   * Max number of results returned by one search.
+   */
+  static constexpr v_int32 MAX_LIMIT = 100;
+
+private:
+
+  struct Entry {
+    oatpp::String pointer;
+    oatpp::String kind;
+    oatpp::String method;
+    oatpp::String path;
+    oatpp::String operationId;
+    oatpp::String summary;
+    oatpp::String name;
+  };
+
+  struct Posting {
+    v_uint32 entry;
+    v_int32 weight;
+  };
+
+  typedef std::pair<std::string, std::vector<Posting>> Term;
+
+private:
+  std::vector<Entry> m_entries;
+  std::vector<Term> m_terms; // sorted by term
+public:
+
+  /**
+   * Constructor. Builds the index.
+   * @param document - &id:oatpp::swagger::oas3::Document;.
+   */
+  SearchIndex(const oatpp::Object<oas3::Document>& document);
+
+  /**
+   * Split text into lower-case terms. Words are split on non-alphanumeric characters and on camelCase boundaries.
+   * @param text - text.
+   * @param compound - also emit the whole word if it was split on camelCase boundaries (`getUserById` -> `getuserbyid`).
+   * @return - list of terms.
+   */
+  static std::vector<std::string> tokenize(const std::string& text, bool compound);
+
+  /**
+   * Search. Each query term matches index terms it is a prefix of; exact matches score higher.
+   * A result must match all query terms.
+   * @param query - query text.
+   * @param limit - max number of results. Capped by &l:SearchIndex::MAX_LIMIT;.
+   * @return - list of &l:SearchResult; ranked by score.
+   */
+  oatpp::List<oatpp::Object<SearchResult>> search(const oatpp::String& query, v_int32 limit) const;
+
+  /**
+   * Get number of distinct terms in the index.
+   * @return - number of terms.
+   */
+  v_int64 getTermsCount() const;
+
+};
+
+}}
+
+#endif // oatpp_swagger_SearchIndex_hpp
@@ -0,0 +1,224 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi, <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "SizeAnalyzer.hpp"
+
+#include "oatpp-swagger/DocumentFragments.hpp"
+
+#include <algorithm>
+#include <unordered_set>
+
+namespace oatpp { namespace swagger {
+
+namespace {
+
+  const std::string PATHS_PREFIX = "/paths/";
+  const std::string SCHEMAS_PREFIX = "/components/schemas/";
+
+  bool startsWith(const std::string& str, const std::string& prefix) {
+    return str.compare(0, prefix.size(), prefix) == 0;
+  }
+
+}
+
+SizeAnalyzer::SizeAnalyzer(const std::shared_ptr<data::mapping::ObjectMapper>& objectMapper, const oatpp::Object<oas3::Document>& document)
+  : m_objectMapper(objectMapper)
+  , m_totalSize(0)
+{
+  if(document) {
+    m_totalSize = static_cast<v_int64>(m_objectMapper->writeToString(document)->size());
+    walk(document, "", 0);
+  }
+}
+
+void SizeAnalyzer::add(Kind kind, const oatpp::Void& node, const std::string& pointer, bool trackCopies) {
+
+  auto data = m_objectMapper->writeToString(node);
+  auto size = static_cast<v_int64>(data->size());
+
+  m_entries[kind].push_back({pointer, size});
+
+  if(trackCopies && size >= MIN_DUPLICATE_SIZE) {
+    auto& copies = m_copies[*data];
+    copies.size = size;
+    copies.pointers.push_back(pointer);
+  }
+
+}
+
+void SizeAnalyzer::walk(const oatpp::Void& node, const std::string& pointer, v_int32 depth) {
+
+  if(!node) {
+    return;
+  }
+
+  auto type = node.getValueType();
+  auto classId = type->classId.id;
+
+  if(type == oatpp::Object<oas3::Schema>::Class::getType()) {
+    if(depth == 3 && startsWith(pointer, SCHEMAS_PREFIX)) {
+      add(SCHEMA, node, pointer, true);
+    } else if(!static_cast<oas3::Schema*>(node.get())->ref) {
+      add(INLINE_SCHEMA, node, pointer, true);
+    }
+  } else if(type == oatpp::Object<oas3::Example>::Class::getType()) {
+    add(EXAMPLE, node, pointer, true);
+  } else if(type == oatpp::Object<oas3::PathItem>::Class::getType() && depth == 2 && startsWith(pointer, PATHS_PREFIX)) {
+    add(PATH, node, pointer, false);
+  } else if(type == oatpp::Object<oas3::PathItemOperation>::Class::getType()) {
+    add(OPERATION, node, pointer, false);
+  }
+
+  if(classId == oatpp::data::type::__class::AbstractObject::CLASS_ID.id) {
+
+    auto dispatcher = static_cast<const oatpp::data::type::__class::AbstractObject::PolymorphicDispatcher*>(type->polymorphicDispatcher);
+    for(auto* p : dispatcher->getProperties()->getList()) {
+      walk(p->get(static_cast<oatpp::BaseObject*>(node.get())), pointer + "/" + DocumentFragments::escapeToken(p->name), depth + 1);
+    }
+
+  } else if(classId == oatpp::data::type::__class::AbstractList::CLASS_ID.id ||
+            classId == oatpp::data::type::__class::AbstractVector::CLASS_ID.id)
+  {
+
+    auto dispatcher = static_cast<const oatpp::data::type::__class::Collection::PolymorphicDispatcher*>(type->polymorphicDispatcher);
+    v_int64 index = 0;
+    for(auto it = dispatcher->beginIteration(node); !it->finished(); it->next()) {
+      walk(it->get(), pointer + "/" + std::to_string(index ++), depth + 1);
+    }
+
+  } else if(classId == oatpp::data::type::__class::AbstractPairList::CLASS_ID.id ||
+            classId == oatpp::data::type::__class::AbstractUnorderedMap::CLASS_ID.id)
+  {
+
+    auto dispatcher = static_cast<const oatpp::data::type::__class::Map::PolymorphicDispatcher*>(type->polymorphicDispatcher);
+    for(auto it = dispatcher->beginIteration(node); !it->finished(); it->next()) {
+      auto key = it->getKey();
+      if(key) {
+        walk(it->getValue(), pointer + "/" + DocumentFragments::escapeToken(*static_cast<std::string*>(key.get())), depth + 1);
+      }
+    }
+
+  }
+
+}
+
+oatpp::List<oatpp::Object<SizeEntry>> SizeAnalyzer::getEntries(const std::vector<Entry>& entries, v_int32 limit) {
+
+  std::vector<const Entry*> sorted;
+  sorted.reserve(entries.size());
+  for(auto& entry : entries) {
+    sorted.push_back(&entry);
+  }
+
+  auto count = std::min(sorted.size(), static_cast<size_t>(limit));
+  std::partial_sort(sorted.begin(), sorted.begin() + static_cast<std::ptrdiff_t>(count), sorted.end(), [](const Entry* a, const Entry* b) {
+    return a->size > b->size || (a->size == b->size && a->pointer < b->pointer);
+  });
+
+  auto result = oatpp::List<oatpp::Object<SizeEntry>>::createShared();
+  for(size_t i = 0; i < count; i++) {
+    auto entry = SizeEntry::createShared();
+    entry->pointer = sorted[i]->pointer;
+    entry->size = sorted[i]->size;
+    result->push_back(entry);
+  }
+
+  return result;
+
+}
+
+oatpp::Object<SizeReport> SizeAnalyzer::getReport(v_int32 limit) const {
+
+  limit = std::max<v_int32>(1, std::min<v_int32>(limit, MAX_LIMIT));
+
+  auto report = SizeReport::createShared();
+  report->totalSize = m_totalSize;
+  report->paths = getEntries(m_entries[PATH], limit);
+  report->operations = getEntries(m_entries[OPERATION], limit);
+  report->schemas = getEntries(m_entries[SCHEMA], limit);
+  report->inlineSchemas = getEntries(m_entries[INLINE_SCHEMA], limit);
+  report->examples = getEntries(m_entries[EXAMPLE], limit);
+
+  std::vector<const Copies*> duplicates;
+  for(auto& copies : m_copies) {
+    if(copies.second.pointers.size() > 1) {
+      duplicates.push_back(&copies.second);
+    }
+  }
+
+  auto wasted = [](const Copies* copies) {
+    return copies->size * static_cast<v_int64>(copies->pointers.size() - 1);
+  };
+
+  std::sort(duplicates.begin(), duplicates.end(), [&wasted](const Copies* a, const Copies* b) {
+    auto wa = wasted(a);
+    auto wb = wasted(b);
+    return wa > wb || (wa == wb && a->pointers.front() < b->pointers.front());
+  });
+
+  // Copies nested in already reported copies are duplicated only because their parents are.
+  std::unordered_set<std::string> reported;
+  auto isNested = [&reported](const std::string& pointer) {
+    for(auto pos = pointer.rfind('/'); pos != std::string::npos && pos > 0; pos = pointer.rfind('/', pos - 1)) {
+      if(reported.find(pointer.substr(0, pos)) != reported.end()) {
+        return true;
+      }
+    }
+    return false;
+  };
+
+  report->duplicates = oatpp::List<oatpp::Object<SizeDuplicate>>::createShared();
+  for(auto* copies : duplicates) {
+
+    if(report->duplicates->size() >= static_cast<size_t>(limit)) {
+      break;
+    }
+
+    if(std::all_of(copies->pointers.begin(), copies->pointers.end(), isNested)) {
+      continue;
+    }
+
+    auto duplicate = SizeDuplicate::createShared();
+    duplicate->size = copies->size;
+    duplicate->count = static_cast<v_int64>(copies->pointers.size());
+    duplicate->wasted = wasted(copies);
+    duplicate->pointers = oatpp::List<oatpp::String>::createShared();
+    for(auto& pointer : copies->pointers) {
+      duplicate->pointers->push_back(pointer);
+      reported.insert(pointer);
+    }
+    report->duplicates->push_back(duplicate);
+
+  }
+
+  return report;
+
+}
+
+v_int64 SizeAnalyzer::getTotalSize() const {
+  return m_totalSize;
+}
+
+}}
@@ -0,0 +1,216 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi, <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef oatpp_swagger_SizeAnalyzer_hpp
+#define oatpp_swagger_SizeAnalyzer_hpp
+
+#include "oatpp-swagger/oas3/Model.hpp"
+
+#include "oatpp/data/mapping/ObjectMapper.hpp"
+#include "oatpp/macro/codegen.hpp"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace oatpp { namespace swagger {
+
+#include OATPP_CODEGEN_BEGIN(DTO)
+
+/**
+ * Serialized size of a node of the document.
+ */
+class SizeEntry : public oatpp::DTO {
+
+  DTO_INIT(SizeEntry, DTO)
+
+  /**
+   * JSON Pointer to the node. Ex.: `/paths/~1users~1{id}/get`, `/components/schemas/UserDto`.
+   */
+  DTO_FIELD(String, pointer);
+
+  /**
+   * Size of the serialized node in bytes, including all nested nodes.
+   */
+  DTO_FIELD(Int64, size);
+
+};
+
+/**
+ * Subtree which is serialized more than once.
+ */
+class SizeDuplicate : public oatpp::DTO {
+
+  DTO_INIT(SizeDuplicate, DTO)
+
+  /**
+   * Size of one copy in bytes.
+   */
+  DTO_FIELD(Int64, size);
+
+  /**
+   * Number of copies.
+   */
+  DTO_FIELD(Int64, count);
+
+  /**
+   * Bytes taken by all copies but one.
+   */
+  DTO_FIELD(Int64, wasted);
+
+  /**
+   * JSON Pointers to the copies.
+   */
+  DTO_FIELD(List<String>, pointers);
+
+};
+
+/**
+ * Report of the &l:SizeAnalyzer;. Each list is sorted by size in descending order.
+ */
+class SizeReport : public oatpp::DTO {
+
+  DTO_INIT(SizeReport, DTO)
+
+  /**
+   * Size of the serialized document in bytes.
+   */
+  DTO_FIELD(Int64, totalSize);
+
+  /**
+   * Entries of `paths`.
+   */
+  DTO_FIELD(List<Object<SizeEntry>>, paths);
+
+  /**
+   * Operations of the path items.
+   */
+  DTO_FIELD(List<Object<SizeEntry>>, operations);
+
+  /**
+   * Entries of `components/schemas`.
+   */
+  DTO_FIELD(List<Object<SizeEntry>>, schemas);
+
+  /**
+   * Schemas which are not `$ref` and are not in `components/schemas` - properties, items, parameters, bodies, responses.
+   */
+  DTO_FIELD(List<Object<SizeEntry>>, inlineSchemas);
+
+  /**
+   * Examples of parameters and media types.
+   */
+  DTO_FIELD(List<Object<SizeEntry>>, examples);
+
+  /**
+   * Schemas and examples serialized more than once. Sorted by &l:SizeDuplicate::wasted; in descending order.
+   */
+  DTO_FIELD(List<Object<SizeDuplicate>>, duplicates);
+
+};
+
+#include OATPP_CODEGEN_END(DTO)
+
+/**
+ * Attributes bytes of the serialized API document to its paths, operations, schemas and examples,
+ * and finds the largest duplicated subtrees. <br>
+ * Each node is serialized separately, so the analysis costs a multiple of the document serialization.
+ * Meant for debugging - run it once per document.
+ */
+class SizeAnalyzer {
+public:
+
+  /**
+   * Default max number of entries in each list of the report.
+   */
+  static constexpr v_int32 DEFAULT_LIMIT = 20;
+
+  /**
+   * Max number of entries in each list of the report.
+   */
+  static constexpr v_int32 MAX_LIMIT = 1000;
+
+  /**
+   * Subtrees smaller than this (in bytes) are not reported as duplicates.
+   */
+  static constexpr v_int64 MIN_DUPLICATE_SIZE = 64;
+
+private:
+
+  enum Kind : v_int32 {
+    PATH = 0,
+    OPERATION = 1,
+    SCHEMA = 2,
+    INLINE_SCHEMA = 3,
+    EXAMPLE = 4,
+    KINDS_COUNT = 5
+  };
+
+  struct Entry {
+    std::string pointer;
+    v_int64 size;
+  };
+
+  struct Copies {
+    v_int64 size;
+    std::vector<std::string> pointers;
+  };
+
+private:
+  std::shared_ptr<data::mapping::ObjectMapper> m_objectMapper;
+  v_int64 m_totalSize;
+  std::vector<Entry> m_entries[KINDS_COUNT];
+  std::unordered_map<std::string, Copies> m_copies; // serialized subtree -> copies
+private:
+  void walk(const oatpp::Void& node, const std::string& pointer, v_int32 depth);
+  void add(Kind kind, const oatpp::Void& node, const std::string& pointer, bool trackCopies);
+  static oatpp::List<oatpp::Object<SizeEntry>> getEntries(const std::vector<Entry>& entries, v_int32 limit);
+public:
+
+  /**
+   * Constructor. Analyzes the document.
+   * @param objectMapper - &id:oatpp::data::mapping::ObjectMapper; used to serialize the document.
+   * @param document - &id:oatpp::swagger::oas3::Document;.
+   */
+  SizeAnalyzer(const std::shared_ptr<data::mapping::ObjectMapper>& objectMapper, const oatpp::Object<oas3::Document>& document);
+
+  /**
+   * Get report.
+   * @param limit - max number of entries in each list. Clamped to [1, &l:SizeAnalyzer::MAX_LIMIT;].
+   * @return - &l:SizeReport;.
+   */
+  oatpp::Object<SizeReport> getReport(v_int32 limit = DEFAULT_LIMIT) const;
+
+  /**
+   * Get size of the serialized document.
+   * @return - size in bytes.
+   */
+  v_int64 getTotalSize() const;
+
+};
+
+}}
+
+#endif // oatpp_swagger_SizeAnalyzer_hpp
@@ -0,0 +1,245 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi, <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "TagDocuments.hpp"
+
+#include <unordered_set>
+
+namespace oatpp { namespace swagger {
+
+TagDocuments::TagDocuments(const std::shared_ptr<data::mapping::ObjectMapper>& objectMapper, const oatpp::Object<oas3::Document>& document)
+  : m_objectMapper(objectMapper)
+  , m_document(document)
+{
+
+  std::unordered_set<oatpp::String> tags;
+
+  if(m_document->paths) {
+    for(auto& path : *m_document->paths) {
+      for(auto* operation : getOperations(path.second)) {
+        if(!*operation) {
+          continue;
+        }
+        if(!(*operation)->tags || (*operation)->tags->empty()) {
+          if(tags.insert(DEFAULT_TAG).second) {
+            m_tags.push_back(DEFAULT_TAG);
+          }
+          continue;
+        }
+        for(auto& tag : *(*operation)->tags) {
+          if(tag && tags.insert(tag).second) {
+            m_tags.push_back(tag);
+          }
+        }
+      }
+    }
+  }
+
+  if(m_document->components && m_document->components->schemas) {
+    for(auto& schema : *m_document->components->schemas) {
+      m_schemas[schema.first] = schema.second;
+    }
+  }
+
+}
+
+TagDocuments::Operations TagDocuments::getOperations(const oatpp::Object<oas3::PathItem>& pathItem) {
+  return {
+    &pathItem->operationGet,
+    &pathItem->operationPut,
+    &pathItem->operationPost,
+    &pathItem->operationDelete,
+    &pathItem->operationOptions,
+    &pathItem->operationHead,
+    &pathItem->operationPatch,
+    &pathItem->operationTrace
+  };
+}
+
+bool TagDocuments::hasTag(const oatpp::Object<oas3::PathItemOperation>& operation, const oatpp::String& tag) {
+  if(!operation->tags || operation->tags->empty()) {
+    return tag == DEFAULT_TAG;
+  }
+  for(auto& t : *operation->tags) {
+    if(t == tag) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void TagDocuments::collectRefs(const oatpp::Object<oas3::Schema>& schema, std::vector<oatpp::String>& refs) {
+
+  static const std::string PREFIX = "#/components/schemas/";
+
+  if(!schema) {
+    return;
+  }
+
+  if(schema->ref && schema->ref->compare(0, PREFIX.size(), PREFIX) == 0) {
+    refs.push_back(schema->ref->substr(PREFIX.size()));
+  }
+
+  if(schema->properties) {
+    for(auto& property : *schema->properties) {
+      collectRefs(property.second, refs);
+    }
+  }
+
+  collectRefs(schema->additionalProperties, refs);
+  collectRefs(schema->items, refs);
+
+}
+
+void TagDocuments::collectRefs(const oatpp::Object<oas3::PathItemOperation>& operation, std::vector<oatpp::String>& refs) {
+
+  if(operation->parameters) {
+    for(auto& parameter : *operation->parameters) {
+      collectRefs(parameter->schema, refs);
+    }
+  }
+
+  if(operation->requestBody && operation->requestBody->content) {
+    for(auto& mediaType : *operation->requestBody->content) {
+      collectRefs(mediaType.second->schema, refs);
+    }
+  }
+
+  if(operation->responses) {
+    for(auto& response : *operation->responses) {
+      if(response.second->content) {
+        for(auto& mediaType : *response.second->content) {
+          collectRefs(mediaType.second->schema, refs);
+        }
+      }
+    }
+  }
+
+}
+
+oatpp::Object<oas3::Document> TagDocuments::createDocument(const oatpp::String& tag) const {
+
+  auto document = oas3::Document::createShared();
+  document->openapi = m_document->openapi;
+  document->info = m_document->info;
+  document->servers = m_document->servers;
+  document->paths = oatpp::Fields<oatpp::Object<oas3::PathItem>>::createShared();
+
+  std::vector<oatpp::String> refs;
+
+  if(m_document->paths) {
+    for(auto& path : *m_document->paths) {
+
+      oatpp::Object<oas3::PathItem> pathItem;
+      auto source = getOperations(path.second);
+
+      for(size_t i = 0; i < source.size(); i++) {
+        if(*source[i] && hasTag(*source[i], tag)) {
+          if(!pathItem) {
+            pathItem = oas3::PathItem::createShared();
+          }
+          *getOperations(pathItem)[i] = *source[i];
+          collectRefs(*source[i], refs);
+        }
+      }
+
+      if(pathItem) {
+        document->paths->push_back({path.first, pathItem});
+      }
+
+    }
+  }
+
+  if(m_document->components) {
+
+    document->components = oas3::Components::createShared();
+    document->components->securitySchemes = m_document->components->securitySchemes;
+
+    if(m_document->components->schemas) {
+
+      std::unordered_set<oatpp::String> used;
+      while(!refs.empty()) {
+        auto name = refs.back();
+        refs.pop_back();
+        if(used.insert(name).second) {
+          auto it = m_schemas.find(name);
+          if(it != m_schemas.end()) {
+            collectRefs(it->second, refs);
+          }
+        }
+      }
+
+      // keep the order of the original document
+      document->components->schemas = oatpp::Fields<oatpp::Object<oas3::Schema>>::createShared();
+      for(auto& schema : *m_document->components->schemas) {
+        if(used.find(schema.first) != used.end()) {
+          document->components->schemas->push_back(schema);
+        }
+      }
+
+    }
+
+  }
+
+  return document;
+
+}
+
+const std::vector<oatpp::String>& TagDocuments::getTags() const {
+  return m_tags;
+}
+
+std::shared_ptr<DocumentCache> TagDocuments::getDocument(const oatpp::String& tag) {
+
+  if(!tag) {
+    return nullptr;
+  }
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  auto it = m_documents.find(tag);
+  if(it != m_documents.end()) {
+    return it->second;
+  }
+
+  bool known = false;
+  for(auto& t : m_tags) {
+    if(t == tag) {
+      known = true;
+      break;
+    }
+  }
+
+  if(!known) {
+    return nullptr;
+  }
+
+  auto document = std::make_shared<DocumentCache>(m_objectMapper, createDocument(tag));
+  m_documents[tag] = document;
+  return document;
+
+}
+
+}}
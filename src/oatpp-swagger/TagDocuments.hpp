@@ -0,0 +1,94 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi, <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef oatpp_swagger_TagDocuments_hpp
+#define oatpp_swagger_TagDocuments_hpp
+
+#include "oatpp-swagger/DocumentCache.hpp"
+
+#include <array>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace oatpp { namespace swagger {
+
+/**
+ * Per-tag sub-documents of the API document. <br>
+ * Each sub-document contains only the operations of one tag and the transitive closure of
+ * `components/schemas` referenced by them. Sub-documents are generated and serialized on the first request and cached.
+ */
+class TagDocuments {
+public:
+
+  /**
+   * Tag of the operations which don't have tags. Same as Swagger-UI uses to group them.
+   */
+  static constexpr const char* const DEFAULT_TAG = "default";
+
+  typedef std::array<oatpp::Object<oas3::PathItemOperation>*, 8> Operations;
+
+private:
+  static Operations getOperations(const oatpp::Object<oas3::PathItem>& pathItem);
+  static bool hasTag(const oatpp::Object<oas3::PathItemOperation>& operation, const oatpp::String& tag);
+  static void collectRefs(const oatpp::Object<oas3::Schema>& schema, std::vector<oatpp::String>& refs);
+  static void collectRefs(const oatpp::Object<oas3::PathItemOperation>& operation, std::vector<oatpp::String>& refs);
+private:
+  std::shared_ptr<data::mapping::ObjectMapper> m_objectMapper;
+  oatpp::Object<oas3::Document> m_document;
+  std::vector<oatpp::String> m_tags;
+  std::unordered_map<oatpp::String, oatpp::Object<oas3::Schema>> m_schemas;
+private:
+  std::mutex m_mutex;
+  std::unordered_map<oatpp::String, std::shared_ptr<DocumentCache>> m_documents;
+private:
+  oatpp::Object<oas3::Document> createDocument(const oatpp::String& tag) const;
+public:
+
+  /**
+   * Constructor. Collects tags of the document. Sub-documents are not generated here.
+   * @param objectMapper - &id:oatpp::data::mapping::ObjectMapper; to serialize sub-documents with.
+   * @param document - &id:oatpp::swagger::oas3::Document;.
+   */
+  TagDocuments(const std::shared_ptr<data::mapping::ObjectMapper>& objectMapper, const oatpp::Object<oas3::Document>& document);
+
+  /**
+   * Get tags of the document in order of their first occurrence.
+   * @return - list of tags.
+   */
+  const std::vector<oatpp::String>& getTags() const;
+
+  /**
+   * Get sub-document of the tag. Generated on the first call.
+   * @param tag - tag name.
+   * @return - &id:oatpp::swagger::DocumentCache; or `nullptr` if the document has no operations with this tag.
+   */
+  std::shared_ptr<DocumentCache> getDocument(const oatpp::String& tag);
+
+};
+
+}}
+
+#endif // oatpp_swagger_TagDocuments_hpp
@@ -0,0 +1,344 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi, <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "UiRenderer.hpp"
+
+#include "oatpp/encoding/Base64.hpp"
+#include "oatpp/encoding/Url.hpp"
+#include "oatpp/base/Log.hpp"
+
+#include <cstdio>
+
+namespace oatpp { namespace swagger {
+
+std::string UiRenderer::escapeForScript(const oatpp::String& json) {
+
+  // JSON allows U+2028 and U+2029 in strings while older JavaScript engines don't.
+  // `</` is escaped as `<\/` (only possible inside JSON strings) so that the spec can't end an inline <script>.
+  std::string result;
+  result.reserve(json->size());
+
+  const char* data = json->data();
+  v_buff_size size = static_cast<v_buff_size>(json->size());
+
+  for(v_buff_size i = 0; i < size; i++) {
+    if(i + 2 < size &&
+       static_cast<v_uint8>(data[i]) == 0xE2 && static_cast<v_uint8>(data[i + 1]) == 0x80 &&
+       (static_cast<v_uint8>(data[i + 2]) == 0xA8 || static_cast<v_uint8>(data[i + 2]) == 0xA9))
+    {
+      result.append(static_cast<v_uint8>(data[i + 2]) == 0xA8 ? "\\u2028" : "\\u2029");
+      i += 2;
+    } else if(data[i] == '<' && i + 1 < size && data[i + 1] == '/') {
+      result.append("<\\/");
+      i += 1;
+    } else {
+      result.push_back(data[i]);
+    }
+  }
+
+  return result;
+
+}
+
+std::string UiRenderer::escapeString(const oatpp::String& str) {
+  std::string result;
+  result.reserve(str->size());
+  for(char c : *str) {
+    switch(c) {
+      case '"': result.append("\\\""); break;
+      case '\\': result.append("\\\\"); break;
+      case '<': result.append("\\u003c"); break;
+      default:
+        if(static_cast<v_uint8>(c) < 0x20) {
+          char buffer[8];
+          std::snprintf(buffer, sizeof(buffer), "\\u%04x", static_cast<unsigned>(c));
+          result.append(buffer);
+        } else {
+          result.push_back(c);
+        }
+    }
+  }
+  return result;
+}
+
+bool UiRenderer::isSpecPreloaded(const ControllerConfig& config) {
+  return config.preloadSpec && !config.inlineSpec && !config.splitByTag;
+}
+
+std::string UiRenderer::renderUrls(const ControllerPaths& paths, const std::vector<oatpp::String>& tags) {
+
+  std::string apiTag = paths.apiTag;
+  auto prefix = "/" + apiTag.substr(0, apiTag.find("{tag}"));
+
+  oatpp::encoding::Url::Config urlConfig;
+
+  std::string urls = "urls: [";
+  for(auto& tag : tags) {
+    urls += "{url: \"" + prefix + *oatpp::encoding::Url::encode(tag, urlConfig) + "\", name: \"" + escapeString(tag) + "\"}, ";
+  }
+  urls += "{url: \"/" + *paths.apiJson + "\", name: \"(all)\"}]";
+
+  return urls;
+
+}
+
+oatpp::String UiRenderer::renderVersionPath(const ControllerPaths& paths, const oatpp::String& version) {
+  std::string path = paths.apiVersion;
+  return path.substr(0, path.find("{version}")) + *version + ".json";
+}
+
+oatpp::String UiRenderer::renderInitializer(const Resources& resources,
+                                            const ControllerPaths& paths,
+                                            const ControllerConfig& config,
+                                            const oatpp::String& spec,
+                                            const std::vector<oatpp::String>& tags)
+{
+
+  static const std::string URL_TOKEN = "url: \"/%%API.JSON%%\"";
+  static const std::string PLACEHOLDER = "%%API.JSON%%";
+
+  std::string ui = resources.getResourceData("swagger-initializer.js");
+
+  if(config.inlineSpec && spec) {
+    auto pos = ui.find(URL_TOKEN);
+    if(pos != std::string::npos) {
+      ui.replace(pos, URL_TOKEN.size(), "spec: " + escapeForScript(spec));
+      return ui;
+    }
+    OATPP_LOGw("oatpp::swagger::UiRenderer::renderInitializer()", "Can't inline spec - '{}' not found in swagger-initializer.js", URL_TOKEN);
+  } else if(config.splitByTag && !tags.empty()) {
+    auto pos = ui.find(URL_TOKEN);
+    if(pos != std::string::npos) {
+      ui.replace(pos, URL_TOKEN.size(), renderUrls(paths, tags));
+      return ui;
+    }
+    OATPP_LOGw("oatpp::swagger::UiRenderer::renderInitializer()", "Can't split spec by tag - '{}' not found in swagger-initializer.js", URL_TOKEN);
+  }
+
+  auto pos = ui.find(PLACEHOLDER);
+  if(pos != std::string::npos) {
+    ui.replace(pos, PLACEHOLDER.size(), paths.apiJson);
+  }
+  return ui;
+
+}
+
+std::string UiRenderer::getAttribute(const std::string& tag, const std::string& name) {
+  auto token = " " + name + "=\"";
+  auto pos = tag.find(token);
+  if(pos == std::string::npos) {
+    return "";
+  }
+  pos += token.size();
+  auto end = tag.find('"', pos);
+  if(end == std::string::npos) {
+    return "";
+  }
+  return tag.substr(pos, end - pos);
+}
+
+std::string UiRenderer::getResourceName(const std::string& ref) {
+  if(ref.compare(0, 2, "./") == 0) {
+    return ref.substr(2);
+  }
+  return ref;
+}
+
+std::string UiRenderer::getResourcesPrefix(const ControllerPaths& paths) {
+  std::string uiResources = paths.uiResources;
+  return "/" + uiResources.substr(0, uiResources.find("{filename}"));
+}
+
+void UiRenderer::inlineAssets(std::string& html,
+                              const Resources& resources,
+                              const ControllerConfig& config,
+                              const oatpp::String& initializer)
+{
+
+  size_t pos = 0;
+
+  while((pos = html.find('<', pos)) != std::string::npos) {
+
+    auto end = html.find('>', pos);
+    if(end == std::string::npos) {
+      break;
+    }
+    end ++;
+
+    std::string tag = html.substr(pos, end - pos);
+    std::string replacement;
+    bool replace = false;
+
+    if(tag.compare(0, 6, "<link ") == 0) {
+
+      auto name = getResourceName(getAttribute(tag, "href"));
+      auto rel = getAttribute(tag, "rel");
+      auto size = name.empty() ? -1 : resources.getResourceSize(name);
+
+      if(size >= 0 && size <= config.inlineAssetMaxSize) {
+        oatpp::String data = resources.getResourceData(name);
+        if(rel == "stylesheet" && data->find("</style") == std::string::npos) {
+          replacement = "<style>" + *data + "</style>";
+          replace = true;
+        } else if(rel == "icon") {
+          auto href = "href=\"" + getAttribute(tag, "href") + "\"";
+          auto uri = "href=\"data:" + resources.getMimeType(name) + ";base64," +
+                     *oatpp::encoding::Base64::encode(data->data(), static_cast<v_buff_size>(data->size())) + "\"";
+          replacement = tag;
+          replacement.replace(replacement.find(href), href.size(), uri);
+          replace = true;
+        }
+      }
+
+    } else if(tag.compare(0, 8, "<script ") == 0) {
+
+      auto name = getResourceName(getAttribute(tag, "src"));
+      auto close = html.find("</script>", end);
+
+      oatpp::String data;
+      if(name == "swagger-initializer.js") {
+        data = initializer;
+      } else if(!name.empty()) {
+        auto size = resources.getResourceSize(name);
+        if(size >= 0 && size <= config.inlineAssetMaxSize) {
+          data = resources.getResourceData(name);
+        }
+      }
+
+      if(data && close != std::string::npos &&
+         static_cast<v_int64>(data->size()) <= config.inlineAssetMaxSize &&
+         data->find("</script") == std::string::npos)
+      {
+        end = close + 9;
+        replacement = "<script>" + *data + "</script>";
+        replace = true;
+      }
+
+    }
+
+    if(replace) {
+      html.replace(pos, end - pos, replacement);
+      pos += replacement.size();
+    } else {
+      pos = end;
+    }
+
+  }
+
+}
+
+oatpp::String UiRenderer::renderIndex(const Resources& resources,
+                                      const ControllerPaths& paths,
+                                      const ControllerConfig& config,
+                                      const oatpp::String& initializer)
+{
+
+  bool preloadSpec = isSpecPreloaded(config);
+
+  if(!preloadSpec && !config.inlineSmallAssets) {
+    return nullptr;
+  }
+
+  std::string html = resources.getResourceData("index.html");
+
+  if(config.inlineSmallAssets) {
+    inlineAssets(html, resources, config, initializer);
+  }
+
+  if(preloadSpec) {
+    auto pos = html.find("</head>");
+    if(pos == std::string::npos) {
+      OATPP_LOGw("oatpp::swagger::UiRenderer::renderIndex()", "Can't add preload link - '</head>' not found in index.html");
+    } else {
+      html.insert(pos, "  <link rel=\"preload\" href=\"/" + *paths.apiJson + "\" as=\"fetch\" crossorigin=\"anonymous\" />\n  ");
+    }
+  }
+
+  return html;
+
+}
+
+oatpp::String UiRenderer::renderPreloadLinks(const Resources& resources,
+                                             const ControllerPaths& paths,
+                                             const ControllerConfig& config,
+                                             const oatpp::String& index)
+{
+
+  if(!config.preloadAssets) {
+    return nullptr;
+  }
+
+  std::string html = index ? *index : *resources.getResourceData("index.html");
+  auto prefix = getResourcesPrefix(paths);
+
+  std::string links;
+  auto addLink = [&links](const std::string& href, const char* as) {
+    if(!links.empty()) {
+      links += ", ";
+    }
+    links += "<" + href + ">; rel=preload; as=" + as;
+  };
+
+  size_t pos = 0;
+  while((pos = html.find('<', pos)) != std::string::npos) {
+
+    auto end = html.find('>', pos);
+    if(end == std::string::npos) {
+      break;
+    }
+    std::string tag = html.substr(pos, end + 1 - pos);
+    pos = end + 1;
+
+    if(tag.compare(0, 6, "<link ") == 0 && getAttribute(tag, "rel") == "stylesheet") {
+      auto name = getResourceName(getAttribute(tag, "href"));
+      if(resources.findResource(name)) {
+        addLink(prefix + name, "style");
+      }
+    } else if(tag.compare(0, 8, "<script ") == 0) {
+      auto name = getResourceName(getAttribute(tag, "src"));
+      if(name == "swagger-initializer.js") {
+        addLink("/" + *paths.initializer, "script");
+      } else if(resources.findResource(name)) {
+        addLink(prefix + name, "script");
+      }
+    }
+
+  }
+
+  if(isSpecPreloaded(config)) {
+    if(!links.empty()) {
+      links += ", ";
+    }
+    links += "</" + *paths.apiJson + ">; rel=preload; as=fetch; crossorigin=anonymous";
+  }
+
+  if(links.empty()) {
+    return nullptr;
+  }
+  return links;
+
+}
+
+}}
@@ -0,0 +1,111 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi, <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef oatpp_swagger_UiRenderer_hpp
+#define oatpp_swagger_UiRenderer_hpp
+
+#include "oatpp-swagger/ControllerConfig.hpp"
+#include "oatpp-swagger/ControllerPaths.hpp"
+#include "oatpp-swagger/Resources.hpp"
+
+#include <vector>
+
+namespace oatpp { namespace swagger {
+
+/**
+ * Renders Swagger-UI pages (`index.html`, `swagger-initializer.js`) from the resource templates.
+ * Pages are rendered once per controller.
+ */
+class UiRenderer {
+private:
+  static std::string escapeForScript(const oatpp::String& json);
+  static std::string escapeString(const oatpp::String& str);
+  static bool isSpecPreloaded(const ControllerConfig& config);
+  static std::string renderUrls(const ControllerPaths& paths, const std::vector<oatpp::String>& tags);
+  static std::string getAttribute(const std::string& tag, const std::string& name);
+  static std::string getResourceName(const std::string& ref);
+  static std::string getResourcesPrefix(const ControllerPaths& paths);
+  static void inlineAssets(std::string& html,
+                           const Resources& resources,
+                           const ControllerConfig& config,
+                           const oatpp::String& initializer);
+public:
+
+  /**
+   * Render path of the content-addressed API JSON.
+   * @param paths - &id:oatpp::swagger::ControllerPaths;.
+   * @param version - &id:oatpp::swagger::DocumentCache::getVersion ();.
+   * @return - &id:oatpp::swagger::ControllerPaths::apiVersion; with `{version}` replaced by `<version>.json`.
+   */
+  static oatpp::String renderVersionPath(const ControllerPaths& paths, const oatpp::String& version);
+
+  /**
+   * Render `swagger-initializer.js`.
+   * @param resources - &id:oatpp::swagger::Resources;.
+   * @param paths - &id:oatpp::swagger::ControllerPaths;.
+   * @param config - &id:oatpp::swagger::ControllerConfig;.
+   * @param spec - serialized API document. Embedded into the initializer if &id:oatpp::swagger::ControllerConfig::inlineSpec; is set.
+   * @param tags - tags of the document. Listed as `urls` if &id:oatpp::swagger::ControllerConfig::splitByTag; is set.
+   * @return - rendered initializer.
+   */
+  static oatpp::String renderInitializer(const Resources& resources,
+                                         const ControllerPaths& paths,
+                                         const ControllerConfig& config,
+                                         const oatpp::String& spec,
+                                         const std::vector<oatpp::String>& tags = {});
+
+  /**
+   * Render `index.html`.
+   * @param resources - &id:oatpp::swagger::Resources;.
+   * @param paths - &id:oatpp::swagger::ControllerPaths;.
+   * @param config - &id:oatpp::swagger::ControllerConfig;.
+   * @param initializer - rendered `swagger-initializer.js`. Inlined if &id:oatpp::swagger::ControllerConfig::inlineSmallAssets; is set
+   * and it is small enough.
+   * @return - rendered `index.html` or `nullptr` if the config doesn't require any changes to the original `index.html`.
+   */
+  static oatpp::String renderIndex(const Resources& resources,
+                                   const ControllerPaths& paths,
+                                   const ControllerConfig& config,
+                                   const oatpp::String& initializer);
+
+  /**
+   * Render value of the `Link` header with `rel=preload` entries for the stylesheets and scripts referenced by `index.html`.
+   * @param resources - &id:oatpp::swagger::Resources;.
+   * @param paths - &id:oatpp::swagger::ControllerPaths;.
+   * @param config - &id:oatpp::swagger::ControllerConfig;.
+   * @param index - rendered `index.html` or `nullptr` to use the original one.
+   * @return - value of the `Link` header or `nullptr` if &id:oatpp::swagger::ControllerConfig::preloadAssets; is not set
+   * or there is nothing to preload.
+   */
+  static oatpp::String renderPreloadLinks(const Resources& resources,
+                                          const ControllerPaths& paths,
+                                          const ControllerConfig& config,
+                                          const oatpp::String& index);
+
+};
+
+}}
+
+#endif // oatpp_swagger_UiRenderer_hpp
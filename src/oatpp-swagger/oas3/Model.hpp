@@ -349,6 +349,34 @@ class Schema : public oatpp::DTO {
    * Ref.
    */
   DTO_FIELD(String, ref, "$ref");
+
+  /**
+   * Create shallow copy of the Schema. Nested schemas and lists are shared with the original.
+   * @param model - &l:Schema;.
+   * @param target - preallocated Schema to copy fields to. If `nullptr` a new Schema is created.
+   * @return - Schema.
+   */
+  static Wrapper createShallowCopy(const Wrapper& model, const Wrapper& target = nullptr) {
+    if(model) {
+      auto result = target ? target : createShared();
+      result->type = model->type;
+      result->format = model->format;
+      result->description = model->description;
+      result->defaultValue = model->defaultValue;
+      result->pattern = model->pattern;
+      result->minimum = model->minimum;
+      result->maximum = model->maximum;
+      result->properties = model->properties;
+      result->additionalProperties = model->additionalProperties;
+      result->items = model->items;
+      result->uniqueItems = model->uniqueItems;
+      result->enumValues = model->enumValues;
+      result->required = model->required;
+      result->ref = model->ref;
+      return result;
+    }
+    return nullptr;
+  }
   
 };
 
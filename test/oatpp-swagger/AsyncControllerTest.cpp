@@ -7,9 +7,21 @@
 #include "test-controllers/TestAsyncController.hpp"
 
 #include "oatpp-swagger/AsyncController.hpp"
+
+#include "oatpp-test/web/ClientServerTestRunner.hpp"
+
+#include "oatpp/web/client/ApiClient.hpp"
+#include "oatpp/web/client/HttpRequestExecutor.hpp"
+#include "oatpp/web/server/AsyncHttpConnectionHandler.hpp"
+#include "oatpp/web/server/HttpRouter.hpp"
+#include "oatpp/network/virtual_/client/ConnectionProvider.hpp"
+#include "oatpp/network/virtual_/server/ConnectionProvider.hpp"
+#include "oatpp/network/virtual_/Interface.hpp"
+#include "oatpp/async/Executor.hpp"
 #include "oatpp/json/ObjectMapper.hpp"
+#include "oatpp/macro/component.hpp"
 
-#include <iostream>
+#include <string>
 
 namespace oatpp { namespace test { namespace swagger {
 
@@ -52,6 +64,123 @@ namespace {
 
   };
 
+  /**
+   * Async server and client talking over the virtual interface.
+   */
+  class TestComponent {
+  public:
+
+    OATPP_CREATE_COMPONENT(std::shared_ptr<oatpp::async::Executor>, executor)([] {
+      return std::make_shared<oatpp::async::Executor>(1, 1, 1);
+    }());
+
+    OATPP_CREATE_COMPONENT(std::shared_ptr<oatpp::network::virtual_::Interface>, virtualInterface)([] {
+      return oatpp::network::virtual_::Interface::obtainShared("swagger-async-test");
+    }());
+
+    OATPP_CREATE_COMPONENT(std::shared_ptr<oatpp::network::ServerConnectionProvider>, serverConnectionProvider)([] {
+      OATPP_COMPONENT(std::shared_ptr<oatpp::network::virtual_::Interface>, interface);
+      return oatpp::network::virtual_::server::ConnectionProvider::createShared(interface);
+    }());
+
+    OATPP_CREATE_COMPONENT(std::shared_ptr<oatpp::network::ClientConnectionProvider>, clientConnectionProvider)([] {
+      OATPP_COMPONENT(std::shared_ptr<oatpp::network::virtual_::Interface>, interface);
+      return oatpp::network::virtual_::client::ConnectionProvider::createShared(interface);
+    }());
+
+    OATPP_CREATE_COMPONENT(std::shared_ptr<oatpp::web::server::HttpRouter>, httpRouter)([] {
+      return oatpp::web::server::HttpRouter::createShared();
+    }());
+
+    OATPP_CREATE_COMPONENT(std::shared_ptr<oatpp::network::ConnectionHandler>, serverConnectionHandler)([] {
+      OATPP_COMPONENT(std::shared_ptr<oatpp::web::server::HttpRouter>, router);
+      OATPP_COMPONENT(std::shared_ptr<oatpp::async::Executor>, executor);
+      return oatpp::web::server::AsyncHttpConnectionHandler::createShared(router, executor);
+    }());
+
+  };
+
+#include OATPP_CODEGEN_BEGIN(ApiClient)
+
+  class SwaggerClient : public oatpp::web::client::ApiClient {
+
+    API_CLIENT_INIT(SwaggerClient)
+
+    API_CALL("GET", "/api-docs/oas-3.0.0.json", getApi)
+    API_CALL("GET", "/api-docs/oas-3.0.0.json", getApiIfNoneMatch, HEADER(String, etag, "If-None-Match"))
+    API_CALL("HEAD", "/api-docs/oas-3.0.0.json", headApi)
+
+    API_CALL("GET", "/swagger/{filename}", getResource, PATH(String, filename))
+    API_CALL("HEAD", "/swagger/{filename}", headResource, PATH(String, filename))
+    API_CALL("GET", "/swagger/{filename}", getResourceRange, PATH(String, filename), HEADER(String, range, "Range"))
+    API_CALL("GET", "/swagger/{filename}", getResourceIfRange, PATH(String, filename), HEADER(String, range, "Range"), HEADER(String, etag, "If-Range"))
+
+    API_CALL("GET", "/api-docs/delta", getDelta, QUERY(String, from))
+    API_CALL("GET", "/api-docs/delta", getDeltaWithoutFrom)
+
+    API_CALL("GET", "/api-docs/events", getEvents)
+    API_CALL("GET", "/api-docs/events", getEventsWithDelta, QUERY(String, delta))
+    API_CALL("GET", "/api-docs/events", getEventsSince, HEADER(String, lastEventId, "Last-Event-ID"))
+
+  };
+
+#include OATPP_CODEGEN_END(ApiClient)
+
+  /**
+   * Serve the controller on a fresh server and run the lambda with a client connected to it.
+   */
+  template<typename Lambda>
+  void runWithClient(const std::shared_ptr<oatpp::swagger::AsyncController>& controller,
+                     const std::shared_ptr<oatpp::data::mapping::ObjectMapper>& objectMapper,
+                     const Lambda& lambda)
+  {
+
+    TestComponent testComponent;
+
+    oatpp::test::web::ClientServerTestRunner runner;
+    runner.addController(controller);
+
+    runner.run([&] {
+      OATPP_COMPONENT(std::shared_ptr<oatpp::network::ClientConnectionProvider>, clientConnectionProvider);
+      auto requestExecutor = oatpp::web::client::HttpRequestExecutor::createShared(clientConnectionProvider);
+      lambda(SwaggerClient::createShared(requestExecutor, objectMapper));
+    }, std::chrono::minutes(10));
+
+    OATPP_COMPONENT(std::shared_ptr<oatpp::async::Executor>, executor);
+    executor->waitTasksFinished();
+    executor->stop();
+    executor->join();
+
+  }
+
+  /**
+   * Read the raw (chunked) body of the event stream until the marker shows up or the stream ends.
+   */
+  std::string readEvents(const std::shared_ptr<oatpp::data::stream::InputStream>& stream, const std::string& marker) {
+    std::string text;
+    char buffer[1024];
+    while(text.find(marker) == std::string::npos) {
+      auto res = stream->readSimple(buffer, sizeof(buffer));
+      if(res <= 0) {
+        break;
+      }
+      text.append(buffer, static_cast<size_t>(res));
+    }
+    return text;
+  }
+
+  class EventsComponent {
+  public:
+
+    OATPP_CREATE_COMPONENT(std::shared_ptr<oatpp::swagger::ControllerConfig>, controllerConfig)([] {
+      auto config = std::make_shared<oatpp::swagger::ControllerConfig>();
+      config->events = true;
+      config->eventsKeepAliveInterval = 100;
+      return config;
+    }());
+
+  };
+
 }
 
 void AsyncControllerTest::onRun() {
@@ -70,8 +199,163 @@ void AsyncControllerTest::onRun() {
 
   auto swaggerController = oatpp::swagger::AsyncController::createShared(docEndpoints);
 
-  // TODO test generated document here
-  OATPP_LOGv(TAG, "TODO implement test");
+  runWithClient(swaggerController, objectMapper, [&](const std::shared_ptr<SwaggerClient>& client) {
+
+    { // conditional requests
+
+      auto response = client->getApi();
+      OATPP_ASSERT(response->getStatusCode() == 200);
+      auto etag = response->getHeader("ETag");
+      OATPP_ASSERT(etag);
+      OATPP_ASSERT(*response->readBodyToString() == *swaggerController->getState()->getDocumentCache()->getData());
+
+      auto notModified = client->getApiIfNoneMatch(etag);
+      OATPP_ASSERT(notModified->getStatusCode() == 304);
+      OATPP_ASSERT(notModified->getHeader("ETag") == etag);
+
+      auto modified = client->getApiIfNoneMatch("\"outdated\"");
+      OATPP_ASSERT(modified->getStatusCode() == 200);
+      OATPP_ASSERT(*modified->readBodyToString() == *swaggerController->getState()->getDocumentCache()->getData());
+
+    }
+
+    { // byte ranges
+
+      auto response = client->getResource("index.css");
+      OATPP_ASSERT(response->getStatusCode() == 200);
+      OATPP_ASSERT(response->getHeader("Accept-Ranges") == "bytes");
+      auto etag = response->getHeader("ETag");
+      std::string css = *response->readBodyToString();
+      OATPP_ASSERT(css.size() > 10);
+
+      auto first = client->getResourceRange("index.css", "bytes=0-9");
+      OATPP_ASSERT(first->getStatusCode() == 206);
+      OATPP_ASSERT(*first->getHeader("Content-Range") == "bytes 0-9/" + std::to_string(css.size()));
+      OATPP_ASSERT(*first->readBodyToString() == css.substr(0, 10));
+
+      auto suffix = client->getResourceRange("index.css", "bytes=-5");
+      OATPP_ASSERT(suffix->getStatusCode() == 206);
+      OATPP_ASSERT(*suffix->readBodyToString() == css.substr(css.size() - 5));
+
+      auto unsatisfiable = client->getResourceRange("index.css", "bytes=" + std::to_string(css.size()) + "-");
+      OATPP_ASSERT(unsatisfiable->getStatusCode() == 416);
+      OATPP_ASSERT(*unsatisfiable->getHeader("Content-Range") == "bytes */" + std::to_string(css.size()));
+
+      auto current = client->getResourceIfRange("index.css", "bytes=0-9", etag);
+      OATPP_ASSERT(current->getStatusCode() == 206);
+
+      auto outdated = client->getResourceIfRange("index.css", "bytes=0-9", "\"outdated\"");
+      OATPP_ASSERT(outdated->getStatusCode() == 200);
+      OATPP_ASSERT(*outdated->readBodyToString() == css);
+
+    }
+
+    { // HEAD
+
+      // HEAD responses are checked by the headers only - there is no body to read.
+      auto api = client->headApi();
+      OATPP_ASSERT(api->getStatusCode() == 200);
+      OATPP_ASSERT(*api->getHeader("Content-Length") == std::to_string(swaggerController->getState()->getDocumentCache()->getData()->size()));
+      OATPP_ASSERT(api->getHeader("ETag") == swaggerController->getState()->getDocumentCache()->getETag());
+      OATPP_ASSERT(api->getHeader("Content-Type") == "application/json");
+
+      auto css = client->getResource("index.css");
+      auto cssSize = css->readBodyToString()->size();
+
+      auto resource = client->headResource("index.css");
+      OATPP_ASSERT(resource->getStatusCode() == 200);
+      OATPP_ASSERT(*resource->getHeader("Content-Length") == std::to_string(cssSize));
+      OATPP_ASSERT(resource->getHeader("ETag") == css->getHeader("ETag"));
+      OATPP_ASSERT(resource->getHeader("Accept-Ranges") == "bytes");
+
+      auto unknown = client->headResource("unknown.css");
+      OATPP_ASSERT(unknown->getStatusCode() == 404);
+
+    }
+
+    { // delta
+
+      auto oldVersion = swaggerController->getHistory()->getCurrentVersion();
+
+      auto document = oatpp::swagger::oas3::Document::createShared();
+      document->info = oatpp::swagger::oas3::Info::createShared();
+      document->info->title = "Published";
+      document->info->version = "2.0";
+      swaggerController->setDocument(document);
+      auto newVersion = swaggerController->getHistory()->getCurrentVersion();
+      OATPP_ASSERT(newVersion != oldVersion);
+
+      auto response = client->getDelta(oldVersion);
+      OATPP_ASSERT(response->getStatusCode() == 200);
+      OATPP_ASSERT(response->getHeader("Content-Type") == "application/json-patch+json");
+      OATPP_ASSERT(response->getHeader(oatpp::swagger::DocumentHistory::HEADER_DOCUMENT_VERSION) == newVersion);
+      auto patch = response->readBodyToString();
+      OATPP_ASSERT(patch->find("{\"op\":\"replace\",\"path\":\"/info/version\",\"value\":\"2.0\"}") != std::string::npos);
+
+      auto current = client->getDelta(newVersion);
+      OATPP_ASSERT(current->getStatusCode() == 200);
+      OATPP_ASSERT(*current->readBodyToString() == "[]");
+
+      OATPP_ASSERT(client->getDelta("unknown")->getStatusCode() == 404);
+      OATPP_ASSERT(client->getDeltaWithoutFrom()->getStatusCode() == 400);
+
+    }
+
+    { // events are disabled by default
+      OATPP_ASSERT(client->getEvents()->getStatusCode() == 404);
+    }
+
+  });
+
+  { // events
+
+    EventsComponent eventsComponent;
+    auto eventsController = oatpp::swagger::AsyncController::createShared(docEndpoints);
+
+    runWithClient(eventsController, objectMapper, [&](const std::shared_ptr<SwaggerClient>& client) {
+
+      auto oldVersion = eventsController->getHistory()->getCurrentVersion();
+
+      auto response = client->getEvents();
+      OATPP_ASSERT(response->getStatusCode() == 200);
+      OATPP_ASSERT(response->getHeader("Content-Type") == "text/event-stream");
+      auto stream = response->getBodyStream();
+      OATPP_ASSERT(readEvents(stream, "\n\n").find("id: " + *oldVersion + "\nevent: document\n") != std::string::npos);
+
+      auto upToDate = client->getEventsSince(oldVersion);
+      OATPP_ASSERT(upToDate->getStatusCode() == 200);
+      auto upToDateStream = upToDate->getBodyStream();
+      auto text = readEvents(upToDateStream, ": keep-alive\n\n");
+      OATPP_ASSERT(text.find(": keep-alive\n\n") != std::string::npos);
+      OATPP_ASSERT(text.find("id: ") == std::string::npos);
+
+      auto withDelta = client->getEventsWithDelta("true");
+      OATPP_ASSERT(withDelta->getStatusCode() == 200);
+      auto withDeltaStream = withDelta->getBodyStream();
+      readEvents(withDeltaStream, "\n\n");
+
+      // Subscribers wait suspended on the events wait list - publishing must wake them up.
+      auto document = oatpp::swagger::oas3::Document::createShared();
+      document->info = oatpp::swagger::oas3::Info::createShared();
+      document->info->version = "2.0";
+      eventsController->setDocument(document);
+      auto newVersion = eventsController->getHistory()->getCurrentVersion();
+
+      auto event = "id: " + *newVersion + "\nevent: document\n";
+      OATPP_ASSERT(readEvents(stream, event).find(event) != std::string::npos);
+      OATPP_ASSERT(readEvents(upToDateStream, event).find(event) != std::string::npos);
+      text = readEvents(withDeltaStream, "}]}\n\n");
+      OATPP_ASSERT(text.find(event) != std::string::npos);
+      OATPP_ASSERT(text.find("\"previous\":\"" + *oldVersion + "\"") != std::string::npos);
+      OATPP_ASSERT(text.find("\"patch\":[") != std::string::npos);
+
+      // Closed events end the open streams with the last chunk.
+      eventsController->getEvents()->close();
+      OATPP_ASSERT(readEvents(stream, "\r\n0\r\n\r\n").find("\r\n0\r\n\r\n") != std::string::npos);
+
+    });
+
+  }
 
 }
 
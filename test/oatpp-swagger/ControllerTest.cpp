@@ -7,6 +7,12 @@
 #include "test-controllers/TestController.hpp"
 
 #include "oatpp-swagger/Controller.hpp"
+#include "oatpp-swagger/OperationIndex.hpp"
+#include "oatpp-swagger/PrebuiltResponses.hpp"
+#include "oatpp-swagger/ResponseFactory.hpp"
+#include "oatpp-swagger/ResourceBody.hpp"
+#include "oatpp-swagger/TagDocuments.hpp"
+#include "oatpp-swagger/UiRenderer.hpp"
 #include "oatpp/json/ObjectMapper.hpp"
 #include "oatpp/data/stream/BufferStream.hpp"
 
@@ -59,6 +65,10 @@ namespace {
       return config;
     }());
 
+    OATPP_CREATE_COMPONENT(std::shared_ptr<oatpp::swagger::Metrics>, swaggerMetrics)([] {
+      return std::make_shared<oatpp::swagger::Metrics>();
+    }());
+
   };
 
 }
@@ -119,6 +129,334 @@ void ControllerTest::onRun() {
 
   }
 
+  { // metrics
+
+    auto metrics = swaggerController->getMetrics();
+    OATPP_ASSERT(metrics);
+    OATPP_ASSERT(metrics->getRequestsCount(oatpp::swagger::Metrics::Endpoint::API) == 1);
+    OATPP_ASSERT(metrics->getRequestsCount(oatpp::swagger::Metrics::Endpoint::UI_ROOT) == 1);
+    OATPP_ASSERT(metrics->getFileRequestsCount("index.html") == 1);
+    OATPP_ASSERT(metrics->getCacheHits() == 1);
+    OATPP_ASSERT(metrics->getBytesSent() > 0);
+    OATPP_ASSERT(metrics->getDocumentSize() > 0);
+
+    oatpp::data::stream::BufferOutputStream stream;
+    stream.setOutputStreamIOMode(oatpp::data::stream::IOMode::BLOCKING);
+
+    auto response = swaggerController->metrics();
+    response->send(&stream, &responseBuffer, nullptr);
+
+    auto responseText = stream.toString();
+    OATPP_ASSERT(responseText->find("oatpp_swagger_requests_total{endpoint=\"api\"} 1") != std::string::npos);
+
+  }
+
+  { // index.html content
+
+    oatpp::data::stream::BufferOutputStream stream;
+    stream.setOutputStreamIOMode(oatpp::data::stream::IOMode::BLOCKING);
+
+    auto response = swaggerController->getUIRoot();
+    OATPP_ASSERT(response->getStatus().code == 200);
+    response->send(&stream, &responseBuffer, nullptr);
+
+    OATPP_ASSERT(stream.toString()->find("swagger-ui") != std::string::npos);
+
+  }
+
+  { // metrics - rendered index.html is not a file request
+
+    OATPP_COMPONENT(std::shared_ptr<oatpp::swagger::Resources>, resources);
+
+    oatpp::swagger::ControllerConfig config;
+    config.inlineSmallAssets = true;
+
+    auto metrics = std::make_shared<oatpp::swagger::Metrics>();
+    auto renderingController = std::make_shared<oatpp::swagger::Controller>(objectMapper,
+                                                                            swaggerController->getState()->getDocumentCache()->getDocument(),
+                                                                            resources,
+                                                                            oatpp::swagger::ControllerPaths(),
+                                                                            nullptr,
+                                                                            metrics,
+                                                                            config);
+    OATPP_ASSERT(renderingController->getState()->getUIRoot().data);
+
+    renderingController->getUIRoot(nullptr);
+    OATPP_ASSERT(metrics->getRequestsCount(oatpp::swagger::Metrics::Endpoint::UI_ROOT) == 1);
+    OATPP_ASSERT(metrics->getFileRequestsCount("index.html") == 0);
+
+    renderingController->getUIResource("index.css", nullptr);
+    OATPP_ASSERT(metrics->getFileRequestsCount("index.css") == 1);
+    OATPP_ASSERT(metrics->getCacheHits() == 1);
+
+  }
+
+  { // streamed resources are sent with known size
+
+    OATPP_COMPONENT(std::shared_ptr<oatpp::swagger::DocumentInfo>, documentInfo);
+    OATPP_COMPONENT(std::shared_ptr<oatpp::swagger::Resources>, inMemoryResources);
+
+    auto streamingResources = std::make_shared<oatpp::swagger::Resources>(OATPP_SWAGGER_RES_PATH, true);
+    auto swaggerStreamingController = oatpp::swagger::Controller::createShared(docEndpoints, documentInfo, streamingResources);
+
+    auto expectedSize = static_cast<v_int64>(inMemoryResources->getResourceData("index.css")->size());
+
+    OATPP_ASSERT(streamingResources->getResourceSize("index.css") == expectedSize);
+
+    auto response = swaggerStreamingController->getUIResource("index.css", nullptr);
+    OATPP_ASSERT(response->getBody()->getKnownSize() == expectedSize);
+
+    oatpp::data::stream::BufferOutputStream stream;
+    stream.setOutputStreamIOMode(oatpp::data::stream::IOMode::BLOCKING);
+    response->send(&stream, &responseBuffer, nullptr);
+
+    auto responseText = stream.toString();
+    OATPP_ASSERT(responseText->find("Content-Length: " + std::to_string(expectedSize)) != std::string::npos);
+
+    auto info = streamingResources->getResourceInfo("index.css");
+    OATPP_ASSERT(info.size == expectedSize);
+    OATPP_ASSERT(info.etag);
+    OATPP_ASSERT(info.etag == streamingResources->getResourceETag("index.css"));
+
+    // range of a file - the stream is positioned at the first byte of the range
+    auto expectedData = inMemoryResources->getResourceData("index.css");
+    auto rangeBody = oatpp::swagger::ResourceBody::createShared(streamingResources->getResource("index.css"), expectedSize, 5, 10);
+    OATPP_ASSERT(rangeBody->getKnownSize() == 10);
+
+    oatpp::data::stream::BufferOutputStream rangeStream;
+    oatpp::async::Action rangeAction;
+    char rangeBuffer[4];
+    v_io_size rangeRes;
+    while((rangeRes = rangeBody->read(rangeBuffer, sizeof(rangeBuffer), rangeAction)) > 0) {
+      rangeStream.writeSimple(rangeBuffer, rangeRes);
+    }
+    OATPP_ASSERT(rangeRes == 0);
+    OATPP_ASSERT(*rangeStream.toString() == expectedData->substr(5, 10));
+
+    // stream is shorter than declared - the body fails instead of leaving the client waiting for the missing bytes
+    auto shortStream = std::make_shared<oatpp::data::stream::BufferInputStream>(oatpp::String("abc"));
+    oatpp::swagger::ResourceBody shortBody(shortStream, 10);
+
+    char buffer[16];
+    oatpp::async::Action action;
+    OATPP_ASSERT(shortBody.read(buffer, sizeof(buffer), action) == 3);
+    OATPP_ASSERT(shortBody.read(buffer, sizeof(buffer), action) < 0);
+
+  }
+
+  { // HEAD - headers only, no body
+
+    OATPP_COMPONENT(std::shared_ptr<oatpp::swagger::Resources>, resources);
+    auto expectedSize = resources->getResourceSize("swagger-ui-bundle.js");
+
+    auto metrics = swaggerController->getMetrics();
+    auto requestsCount = metrics->getRequestsCount(oatpp::swagger::Metrics::Endpoint::UI_RESOURCE);
+    auto bytesSent = metrics->getBytesSent();
+
+    auto response = swaggerController->headUIResource("swagger-ui-bundle.js", nullptr);
+
+    oatpp::data::stream::BufferOutputStream stream;
+    stream.setOutputStreamIOMode(oatpp::data::stream::IOMode::BLOCKING);
+    response->send(&stream, &responseBuffer, nullptr);
+
+    auto responseText = stream.toString();
+    OATPP_ASSERT(responseText->find("Content-Length: " + std::to_string(expectedSize)) != std::string::npos);
+    OATPP_ASSERT(responseText->find("ETag: " + *resources->getResourceETag("swagger-ui-bundle.js")) != std::string::npos);
+    OATPP_ASSERT(static_cast<v_int64>(responseText->size()) < expectedSize);
+
+    // HEAD is not counted - nothing is sent
+    OATPP_ASSERT(metrics->getRequestsCount(oatpp::swagger::Metrics::Endpoint::UI_RESOURCE) == requestsCount);
+    OATPP_ASSERT(metrics->getBytesSent() == bytesSent);
+    OATPP_ASSERT(metrics->getFileRequestsCount("swagger-ui-bundle.js") == 0);
+
+    bool notFound = false;
+    try {
+      swaggerController->headUIResource("unknown.js", nullptr);
+    } catch (oatpp::web::protocol::http::HttpError& e) {
+      notFound = e.getInfo().status.code == 404;
+    }
+    OATPP_ASSERT(notFound);
+
+  }
+
+  { // byte ranges
+
+    typedef oatpp::swagger::ResponseFactory ResponseFactory;
+    ResponseFactory::ByteRange range;
+
+    OATPP_ASSERT(ResponseFactory::parseRange("bytes=0-9", 100, range) == ResponseFactory::RangeResult::SATISFIABLE);
+    OATPP_ASSERT(range.first == 0 && range.last == 9);
+
+    OATPP_ASSERT(ResponseFactory::parseRange("bytes=90-", 100, range) == ResponseFactory::RangeResult::SATISFIABLE);
+    OATPP_ASSERT(range.first == 90 && range.last == 99);
+
+    OATPP_ASSERT(ResponseFactory::parseRange("bytes=-10", 100, range) == ResponseFactory::RangeResult::SATISFIABLE);
+    OATPP_ASSERT(range.first == 90 && range.last == 99);
+
+    OATPP_ASSERT(ResponseFactory::parseRange("bytes=50-1000", 100, range) == ResponseFactory::RangeResult::SATISFIABLE);
+    OATPP_ASSERT(range.first == 50 && range.last == 99);
+
+    OATPP_ASSERT(ResponseFactory::parseRange("bytes=100-", 100, range) == ResponseFactory::RangeResult::UNSATISFIABLE);
+    OATPP_ASSERT(ResponseFactory::parseRange("bytes=0-1,5-6", 100, range) == ResponseFactory::RangeResult::NONE);
+    OATPP_ASSERT(ResponseFactory::parseRange("items=0-1", 100, range) == ResponseFactory::RangeResult::NONE);
+    OATPP_ASSERT(ResponseFactory::parseRange("bytes=9-0", 100, range) == ResponseFactory::RangeResult::NONE);
+
+    oatpp::String data = "0123456789";
+    oatpp::swagger::ResourceBody body(data, 2, 3);
+    OATPP_ASSERT(body.getKnownSize() == 3);
+
+    char buffer[16];
+    oatpp::async::Action action;
+    auto res = body.read(buffer, sizeof(buffer), action);
+    OATPP_ASSERT(res == 3);
+    OATPP_ASSERT(std::string(buffer, 3) == "234");
+    OATPP_ASSERT(body.read(buffer, sizeof(buffer), action) == 0);
+
+  }
+
+  { // prebuilt responses
+
+    oatpp::swagger::PrebuiltResponses prebuilt;
+    prebuilt.addEndpoint("index.html", oatpp::swagger::ResponseFactory::createContent("hello", "text/plain"));
+    prebuilt.addResource("index.html", oatpp::swagger::ResponseFactory::createContent("<html/>", "text/html"));
+
+    OATPP_ASSERT(prebuilt.getSize() == 2);
+    OATPP_ASSERT(prebuilt.getEndpoint("unknown", nullptr) == nullptr);
+    OATPP_ASSERT(prebuilt.getResource("unknown", nullptr) == nullptr);
+
+    // paths and file names don't shadow each other
+    auto response = prebuilt.getEndpoint("index.html", nullptr);
+    OATPP_ASSERT(response);
+    OATPP_ASSERT(response->getBody()->getKnownSize() == 5);
+    OATPP_ASSERT(response->getHeader("ETag"));
+    OATPP_ASSERT(response->getHeader("Content-Type") == "text/plain");
+
+    response = prebuilt.getResource("index.html", nullptr);
+    OATPP_ASSERT(response);
+    OATPP_ASSERT(response->getBody()->getKnownSize() == 7);
+    OATPP_ASSERT(response->getHeader("Content-Type") == "text/html");
+
+    // each request gets its own response - headers added by the server don't leak into the prebuilt ones
+    response->putHeader("Connection", "close");
+    OATPP_ASSERT(!prebuilt.getResource("index.html", nullptr)->getHeader("Connection"));
+
+  }
+
+  { // per-tag documents endpoint
+
+    auto response = swaggerController->apiTag(oatpp::swagger::TagDocuments::DEFAULT_TAG, nullptr);
+    OATPP_ASSERT(response->getStatus().code == 200);
+
+    // split on the first request and kept for the document
+    auto state = swaggerController->getState();
+    OATPP_ASSERT(state->getTagDocuments() == state->getTagDocuments());
+
+    bool notFound = false;
+    try {
+      swaggerController->apiTag("unknown", nullptr);
+    } catch (oatpp::web::protocol::http::HttpError& e) {
+      notFound = e.getInfo().status.code == 404;
+    }
+    OATPP_ASSERT(notFound);
+
+  }
+
+  { // operation index
+
+    oatpp::data::stream::BufferOutputStream stream;
+    stream.setOutputStreamIOMode(oatpp::data::stream::IOMode::BLOCKING);
+
+    auto response = swaggerController->apiIndex(nullptr);
+    OATPP_ASSERT(response->getStatus().code == 200);
+    OATPP_ASSERT(response->getHeader("ETag"));
+    response->send(&stream, &responseBuffer, nullptr);
+
+    auto responseText = stream.toString();
+    utils::parser::Caret caret(responseText);
+    caret.findChar('[');
+
+    auto entries = objectMapper->readFromCaret<oatpp::List<oatpp::Object<oatpp::swagger::OperationIndexEntry>>>(caret);
+    OATPP_ASSERT(caret.hasError() == false);
+    OATPP_ASSERT(entries->size() > 0);
+    for(auto& entry : *entries) {
+      OATPP_ASSERT(entry->method);
+      OATPP_ASSERT(entry->path);
+    }
+    OATPP_ASSERT(responseText->find("\"schema\"") == std::string::npos);
+
+  }
+
+  { // publish a new document
+
+    auto publishController = oatpp::swagger::Controller::createShared(docEndpoints);
+
+    auto mapper = std::make_shared<oatpp::json::ObjectMapper>();
+    mapper->serializerConfig().mapper.includeNullFields = false;
+
+    auto document = oatpp::swagger::oas3::Document::createShared();
+    document->info = oatpp::swagger::oas3::Info::createShared();
+    document->info->title = "Published";
+    document->info->version = "2.0";
+    auto cache = std::make_shared<oatpp::swagger::DocumentCache>(mapper, document);
+
+    auto oldVersion = publishController->getHistory()->getCurrentVersion();
+    OATPP_ASSERT(publishController->getState()->getDocumentCache()->getVersion() == oldVersion);
+    publishController->setDocument(document);
+    OATPP_ASSERT(publishController->getState()->getDocumentCache()->getVersion() == cache->getVersion());
+    OATPP_ASSERT(publishController->api(nullptr)->getHeader("ETag") == cache->getETag());
+    OATPP_ASSERT(publishController->getHistory()->getPatch(oldVersion).data);
+  }
+
+  { // content-addressed spec
+
+    auto state = swaggerController->getState();
+    auto version = state->getDocumentCache()->getVersion();
+    oatpp::swagger::ControllerPaths paths;
+
+    auto path = oatpp::swagger::UiRenderer::renderVersionPath(paths, version);
+    OATPP_ASSERT(path == "api-docs/oas-3.0.0/" + *version + ".json");
+
+    auto response = swaggerController->apiVersion(*version + ".json", nullptr);
+    OATPP_ASSERT(response->getStatus().code == 200);
+    OATPP_ASSERT(response->getHeader("Cache-Control") == "public, max-age=31536000, immutable");
+    OATPP_ASSERT(response->getHeader("ETag") == state->getDocumentCache()->getETag());
+
+    for(const char* filename : {"unknown.json", "", ".json"}) {
+      bool notFound = false;
+      try {
+        swaggerController->apiVersion(filename, nullptr);
+      } catch (oatpp::web::protocol::http::HttpError& e) {
+        notFound = e.getInfo().status.code == 404;
+      }
+      OATPP_ASSERT(notFound);
+    }
+    OATPP_ASSERT(!swaggerController->getHistory()->getVersionContent(version).data);
+
+    oatpp::swagger::ControllerConfig config;
+    config.contentAddressedSpec = true;
+    config.preloadSpec = true;
+    auto resources = oatpp::swagger::Resources::loadResources(OATPP_SWAGGER_RES_PATH);
+    auto mapper = std::make_shared<oatpp::json::ObjectMapper>();
+    mapper->serializerConfig().mapper.includeNullFields = false;
+    oatpp::swagger::DocumentState addressed(mapper, state->getDocumentCache()->getDocument(), *resources, paths, config);
+    OATPP_ASSERT(addressed.getInitializer().data->find("url: \"/" + *path + "\"") != std::string::npos);
+    OATPP_ASSERT(addressed.getUIRoot().data->find("href=\"/" + *path + "\"") != std::string::npos);
+
+  }
+
+  { // size report endpoint
+
+    // disabled by default
+    bool notFound = false;
+    try {
+      swaggerController->sizeReport(nullptr);
+    } catch (oatpp::web::protocol::http::HttpError& e) {
+      notFound = e.getInfo().status.code == 404;
+    }
+    OATPP_ASSERT(notFound);
+
+  }
+
   // TODO test generated document here
   OATPP_LOGv(TAG, "TODO implement test");
 
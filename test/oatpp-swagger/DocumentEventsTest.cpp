@@ -0,0 +1,112 @@
+#include "DocumentEventsTest.hpp"
+
+#include "oatpp-swagger/DocumentEvents.hpp"
+#include "oatpp/json/ObjectMapper.hpp"
+
+#include <string>
+
+namespace oatpp { namespace test { namespace swagger {
+
+namespace {
+
+  oatpp::Object<oatpp::swagger::oas3::Document> createDocument(const char* version) {
+    auto document = oatpp::swagger::oas3::Document::createShared();
+    document->info = oatpp::swagger::oas3::Info::createShared();
+    document->info->version = version;
+    return document;
+  }
+
+  /**
+   * Read as the coroutine would: if the subscription asks to wait, read again as if woken up
+   * (by an event or by the keep-alive deadline).
+   */
+  std::string readEvent(const std::shared_ptr<oatpp::swagger::DocumentEvents::Subscription>& subscription) {
+    char buffer[1024];
+    oatpp::async::Action action;
+    auto res = subscription->read(buffer, sizeof(buffer), action);
+    if(res == oatpp::IOError::RETRY_READ) {
+      OATPP_ASSERT(!action.isNone());
+      oatpp::async::Action wakeUp;
+      res = subscription->read(buffer, sizeof(buffer), wakeUp);
+    }
+    if(res <= 0) {
+      return std::string();
+    }
+    return std::string(buffer, static_cast<size_t>(res));
+  }
+
+}
+
+void DocumentEventsTest::onRun() {
+
+  auto mapper = std::make_shared<oatpp::json::ObjectMapper>();
+  mapper->serializerConfig().mapper.includeNullFields = false;
+
+  auto d1 = std::make_shared<oatpp::swagger::DocumentCache>(mapper, createDocument("1.0"));
+  auto d2 = std::make_shared<oatpp::swagger::DocumentCache>(mapper, createDocument("2.0"));
+
+  { // events
+
+    auto history = std::make_shared<oatpp::swagger::DocumentHistory>(mapper);
+    auto events = std::make_shared<oatpp::swagger::DocumentEvents>(history, 10);
+
+    history->push(d1);
+    events->publish(d1->getVersion());
+
+    auto subscription = events->subscribe(true, nullptr);
+    auto upToDate = events->subscribe(false, d1->getVersion());
+    OATPP_ASSERT(events->getSubscribersCount() == 2);
+
+    OATPP_ASSERT(readEvent(subscription) == "id: " + *d1->getVersion() + "\nevent: document\ndata: {\"version\":\"" + *d1->getVersion() + "\"}\n\n");
+    OATPP_ASSERT(readEvent(subscription) == ": keep-alive\n\n");
+    OATPP_ASSERT(readEvent(upToDate) == ": keep-alive\n\n");
+
+    history->push(d2);
+    events->publish(d2->getVersion());
+    events->publish(d2->getVersion());
+
+    auto event = readEvent(subscription);
+    OATPP_ASSERT(event.find("id: " + *d2->getVersion() + "\n") == 0);
+    OATPP_ASSERT(event.find("\"previous\":\"" + *d1->getVersion() + "\"") != std::string::npos);
+    OATPP_ASSERT(event.find("\"patch\":[{\"op\":\"replace\",\"path\":\"/info/version\",\"value\":\"2.0\"}]") != std::string::npos);
+    OATPP_ASSERT(readEvent(upToDate).find("\"previous\":\"" + *d1->getVersion() + "\"}") != std::string::npos);
+
+    events->close();
+    OATPP_ASSERT(readEvent(upToDate).empty());
+    OATPP_ASSERT(readEvent(subscription).empty());
+  }
+
+  { // waiting subscriber
+
+    auto history = std::make_shared<oatpp::swagger::DocumentHistory>(mapper);
+    auto events = std::make_shared<oatpp::swagger::DocumentEvents>(history, 10);
+
+    history->push(d1);
+    events->publish(d1->getVersion());
+
+    {
+      auto subscription = events->subscribe(false, d1->getVersion());
+      char buffer[64];
+      oatpp::async::Action action;
+      OATPP_ASSERT(subscription->read(buffer, sizeof(buffer), action) == oatpp::IOError::RETRY_READ);
+      OATPP_ASSERT(!action.isNone());
+      OATPP_ASSERT(events->getSubscribersCount() == 1);
+
+      // published while waiting - delivered on the next read
+      history->push(d2);
+      events->publish(d2->getVersion());
+      oatpp::async::Action wakeUp;
+      auto res = subscription->read(buffer, sizeof(buffer), wakeUp);
+      OATPP_ASSERT(res > 0 && wakeUp.isNone());
+      OATPP_ASSERT(std::string(buffer, static_cast<size_t>(res)).find("id: " + *d2->getVersion() + "\n") == 0);
+    }
+    OATPP_ASSERT(events->getSubscribersCount() == 0);
+
+    events->close();
+    auto late = events->subscribe(false, nullptr);
+    OATPP_ASSERT(readEvent(late).empty());
+  }
+
+}
+
+}}}
@@ -0,0 +1,19 @@
+
+#ifndef OATPP_SWAGGER_DOCUMENTEVENTSTEST_HPP
+#define OATPP_SWAGGER_DOCUMENTEVENTSTEST_HPP
+
+#include "oatpp-test/UnitTest.hpp"
+
+namespace oatpp { namespace test { namespace swagger {
+
+class DocumentEventsTest : public UnitTest {
+public:
+
+  DocumentEventsTest():UnitTest("TEST[swagger::DocumentEventsTest]"){}
+  void onRun() override;
+
+};
+
+}}}
+
+#endif //OATPP_SWAGGER_DOCUMENTEVENTSTEST_HPP
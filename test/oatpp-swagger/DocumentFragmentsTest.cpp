@@ -0,0 +1,69 @@
+#include "DocumentFragmentsTest.hpp"
+
+#include "oatpp-swagger/DocumentFragments.hpp"
+#include "oatpp/json/ObjectMapper.hpp"
+
+#include <string>
+#include <vector>
+
+namespace oatpp { namespace test { namespace swagger {
+
+void DocumentFragmentsTest::onRun() {
+
+  auto objectMapper = std::make_shared<oatpp::json::ObjectMapper>();
+
+  { // document fragments
+
+    std::vector<std::string> tokens;
+    OATPP_ASSERT(oatpp::swagger::DocumentFragments::parsePointer("/paths/~1users~1{id}/get/a~0b", tokens));
+    OATPP_ASSERT(tokens.size() == 4);
+    OATPP_ASSERT(tokens[1] == "/users/{id}");
+    OATPP_ASSERT(tokens[3] == "a~b");
+    OATPP_ASSERT(!oatpp::swagger::DocumentFragments::parsePointer("paths", tokens));
+    OATPP_ASSERT(!oatpp::swagger::DocumentFragments::parsePointer("/paths/~2", tokens));
+
+    auto document = oatpp::swagger::oas3::Document::createShared();
+    document->info = oatpp::swagger::oas3::Info::createShared();
+    document->info->title = "Fragments";
+    document->paths = oatpp::Fields<oatpp::Object<oatpp::swagger::oas3::PathItem>>::createShared();
+
+    auto users = oatpp::swagger::oas3::PathItem::createShared();
+    users->operationGet = oatpp::swagger::oas3::PathItemOperation::createShared();
+    users->operationGet->operationId = "getUserById";
+    users->operationGet->tags = {"users", "admin"};
+    document->paths->push_back({"/users/{id}", users});
+
+    auto user = oatpp::swagger::oas3::Schema::createShared();
+    user->type = "object";
+    user->properties = {{"name", oatpp::swagger::oas3::Schema::createShared()}};
+    user->properties["name"]->type = "string";
+    document->components = oatpp::swagger::oas3::Components::createShared();
+    document->components->schemas = {{"UserDto", user}};
+
+    oatpp::swagger::DocumentFragments fragments(objectMapper, document, 2);
+
+    OATPP_ASSERT(fragments.resolve("/components/schemas/UserDto").get() == user.get());
+    OATPP_ASSERT(fragments.resolve("/paths/~1users~1{id}/get").get() == users->operationGet.get());
+    OATPP_ASSERT(fragments.resolve("/paths/~1users~1{id}/get/tags/1").get() == users->operationGet->tags[1].get());
+    OATPP_ASSERT(fragments.resolve("/info/title").get() == document->info->title.get());
+    OATPP_ASSERT(fragments.resolve("/components/schemas/UserDto/properties/name/type").get() == user->properties["name"]->type.get());
+    OATPP_ASSERT(fragments.resolve("/components/schemas/Unknown") == nullptr);
+    OATPP_ASSERT(fragments.resolve("/paths/~1users~1{id}/get/tags/2") == nullptr);
+    OATPP_ASSERT(fragments.resolve("/paths/~1users~1{id}/post") == nullptr);
+
+    auto content = fragments.getFragment("/components/schemas/UserDto");
+    OATPP_ASSERT(content.data);
+    OATPP_ASSERT(content.etag);
+    OATPP_ASSERT(content.data->find("\"type\":\"object\"") != std::string::npos);
+    OATPP_ASSERT(fragments.getFragment("/components/schemas/UserDto").data.get() == content.data.get());
+    OATPP_ASSERT(fragments.getFragment("/components/schemas/Unknown").data == nullptr);
+
+    fragments.getFragment("/info");
+    fragments.getFragment("/info/title");
+    OATPP_ASSERT(fragments.getCachedFragmentsCount() == 2);
+
+  }
+
+}
+
+}}}
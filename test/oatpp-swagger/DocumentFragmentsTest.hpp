@@ -0,0 +1,19 @@
+
+#ifndef OATPP_SWAGGER_DOCUMENTFRAGMENTSTEST_HPP
+#define OATPP_SWAGGER_DOCUMENTFRAGMENTSTEST_HPP
+
+#include "oatpp-test/UnitTest.hpp"
+
+namespace oatpp { namespace test { namespace swagger {
+
+class DocumentFragmentsTest : public UnitTest {
+public:
+
+  DocumentFragmentsTest():UnitTest("TEST[swagger::DocumentFragmentsTest]"){}
+  void onRun() override;
+
+};
+
+}}}
+
+#endif //OATPP_SWAGGER_DOCUMENTFRAGMENTSTEST_HPP
@@ -0,0 +1,552 @@
+#include "GeneratorTest.hpp"
+
+#include "test-controllers/TestController.hpp"
+
+#include "oatpp-swagger/Deduplicator.hpp"
+#include "oatpp-swagger/Generator.hpp"
+#include "oatpp/json/ObjectMapper.hpp"
+
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include OATPP_CODEGEN_BEGIN(DTO)
+
+class DedupAddressDto : public oatpp::DTO {
+
+  DTO_INIT(DedupAddressDto, DTO)
+
+  DTO_FIELD(Fields<String>, labels);
+
+  DTO_FIELD_INFO(notes) {
+    info->description = "Notes";
+  };
+  DTO_FIELD(Fields<String>, notes);
+
+};
+
+class DedupContactDto : public oatpp::DTO {
+
+  DTO_INIT(DedupContactDto, DTO)
+
+  DTO_FIELD(Fields<String>, labels);
+  DTO_FIELD(Fields<String>, tags);
+
+};
+
+class StatsDto : public oatpp::DTO {
+
+  DTO_INIT(StatsDto, DTO)
+
+  DTO_FIELD(String, plain);
+
+  DTO_FIELD_INFO(described) {
+    info->description = "Described";
+  };
+  DTO_FIELD(String, described);
+
+  DTO_FIELD(Int32, withDefault) = 1;
+
+};
+
+namespace first {
+
+class SameNameDto : public oatpp::DTO {
+
+  DTO_INIT(SameNameDto, DTO)
+
+  DTO_FIELD(String, first);
+
+};
+
+}
+
+namespace second {
+
+class SameNameDto : public oatpp::DTO {
+
+  DTO_INIT(SameNameDto, DTO)
+
+  DTO_FIELD(Int32, second);
+
+};
+
+}
+
+#include OATPP_CODEGEN_END(DTO)
+
+namespace oatpp { namespace test { namespace swagger {
+
+namespace {
+
+  class ChainObject : public oatpp::BaseObject {
+  public:
+    oatpp::Void next;
+  };
+
+  class ChainObjectDispatcher : public oatpp::data::type::__class::AbstractObject::PolymorphicDispatcher {
+  public:
+    const oatpp::Type* type = nullptr;
+    oatpp::BaseObject::Properties properties;
+  public:
+
+    oatpp::Void createObject() const override {
+      return oatpp::Void(std::make_shared<ChainObject>(), type);
+    }
+
+    const oatpp::BaseObject::Properties* getProperties() const override {
+      return &properties;
+    }
+
+  };
+
+  /*
+   * Runtime-built DTO types. Each type has a single `next` field referencing the next type,
+   * the last type references the first one. Too deep to be written with the DTO macros.
+   */
+  class TypeChain {
+  private:
+    std::vector<std::unique_ptr<std::string>> m_names;
+    std::vector<std::unique_ptr<ChainObjectDispatcher>> m_dispatchers;
+    std::vector<std::unique_ptr<oatpp::BaseObject::Property>> m_properties;
+    std::vector<std::unique_ptr<oatpp::Type>> m_types;
+  public:
+
+    explicit TypeChain(v_int32 length) {
+
+      ChainObject sample;
+      auto offset = reinterpret_cast<v_int64>(&sample.next) - reinterpret_cast<v_int64>(static_cast<oatpp::BaseObject*>(&sample));
+
+      for(v_int32 i = 0; i < length; i++) {
+        m_names.push_back(std::make_unique<std::string>("ChainDto" + std::to_string(i)));
+        auto dispatcher = std::make_unique<ChainObjectDispatcher>();
+        oatpp::Type::Info info;
+        info.nameQualifier = m_names.back()->c_str();
+        info.polymorphicDispatcher = dispatcher.get();
+        m_types.push_back(std::make_unique<oatpp::Type>(oatpp::data::type::__class::AbstractObject::CLASS_ID, info));
+        dispatcher->type = m_types.back().get();
+        m_dispatchers.push_back(std::move(dispatcher));
+      }
+
+      for(v_int32 i = 0; i < length; i++) {
+        m_properties.push_back(std::make_unique<oatpp::BaseObject::Property>(offset, "next", m_types[(i + 1) % length].get()));
+        m_dispatchers[i]->properties.pushBack(m_properties.back().get());
+      }
+
+    }
+
+    const oatpp::Type* getRoot() const {
+      return m_types.front().get();
+    }
+
+  };
+
+  std::shared_ptr<oatpp::swagger::DocumentInfo> createDocumentInfo() {
+
+    oatpp::swagger::DocumentInfo::Builder builder;
+
+    builder
+      .setTitle("Generator test")
+      .setVersion("1.0")
+      .addSecurityScheme("basic_auth", oatpp::swagger::DocumentInfo::SecuritySchemeBuilder::DefaultBasicAuthorizationSecurityScheme());
+
+    return builder.build();
+
+  }
+
+}
+
+void GeneratorTest::onRun() {
+
+  auto objectMapper = std::make_shared<oatpp::json::ObjectMapper>();
+
+  auto mapper = std::make_shared<oatpp::json::ObjectMapper>();
+  mapper->serializerConfig().mapper.includeNullFields = false;
+
+  auto documentInfo = createDocumentInfo();
+
+  oatpp::web::server::api::Endpoints docEndpoints;
+  docEndpoints.append(TestController::createShared(objectMapper)->getEndpoints());
+
+  { // arena allocation
+
+    auto config = std::make_shared<oatpp::swagger::Generator::Config>();
+    config->enableInterpretations = {"test"};
+    auto expected = mapper->writeToString(oatpp::swagger::Generator(config).generateDocument(documentInfo, docEndpoints));
+
+    config->useArena = true;
+    config->arenaChunkSize = 1024;
+
+    oatpp::Object<oatpp::swagger::oas3::Document> document;
+    {
+      oatpp::swagger::Generator generator(config);
+      document = generator.generateDocument(documentInfo, docEndpoints);
+      OATPP_ASSERT(generator.getStats().arenaSize > config->arenaChunkSize);
+      OATPP_ASSERT(mapper->writeToString(document) == expected);
+    }
+
+    // Nodes keep the arena alive - the document stays valid after the generator is gone.
+    OATPP_ASSERT(mapper->writeToString(document) == expected);
+
+    // ... and so do sub-trees retained after the document root is gone.
+    auto pathItem = document->paths->front().second;
+    auto schema = document->components->schemas->front().second;
+    auto expectedPathItem = mapper->writeToString(pathItem);
+    auto expectedSchema = mapper->writeToString(schema);
+    document = nullptr;
+    OATPP_ASSERT(mapper->writeToString(pathItem) == expectedPathItem);
+    OATPP_ASSERT(mapper->writeToString(schema) == expectedSchema);
+
+  }
+
+  { // shared schemas of simple types are never mutated
+
+    auto config = std::make_shared<oatpp::swagger::Generator::Config>();
+    config->enableInterpretations = {"test"};
+    oatpp::swagger::Generator generator(config);
+
+    for(v_int32 i = 0; i < 2; i++) {
+
+      auto schemas = generator.generateDocument(documentInfo, docEndpoints)->components->schemas;
+      auto user = schemas["UserDto"];
+      auto task = schemas["TaskDto"];
+
+      // Plain properties of the same type share one schema instance.
+      auto sharedString = user->properties["first-name"];
+      OATPP_ASSERT(sharedString.get() == user->properties["last-name"].get());
+      OATPP_ASSERT(sharedString.get() == task->properties["description"].get());
+      OATPP_ASSERT(sharedString->type == "string");
+      OATPP_ASSERT(!sharedString->pattern && !sharedString->description && !sharedString->defaultValue);
+
+      // Properties with a pattern or a default value get their own copy.
+      auto referral = user->properties["referral"];
+      OATPP_ASSERT(referral.get() != sharedString.get());
+      OATPP_ASSERT(referral->pattern == "^[^\\s]+$");
+      OATPP_ASSERT(referral->defaultValue);
+
+      auto intVal = user->properties["intVal"];
+      auto id = user->properties["id"];
+      OATPP_ASSERT(intVal.get() != id.get());
+      OATPP_ASSERT(intVal->defaultValue);
+      OATPP_ASSERT(!id->defaultValue);
+
+    }
+
+  }
+
+  { // deeply nested types
+
+    // Deep enough to overflow the stack if types were decomposed recursively.
+    const v_int32 depth = 50000;
+    TypeChain chain(depth);
+
+    auto root = chain.getRoot();
+    oatpp::web::server::api::Endpoints endpoints;
+    endpoints.list.push_back(oatpp::web::server::api::Endpoint::createShared(nullptr, [root]() {
+      auto info = oatpp::web::server::api::Endpoint::Info::createShared();
+      info->name = "getChain";
+      info->method = "GET";
+      info->path = "/chain";
+      info->addResponse<oatpp::Void>(oatpp::web::protocol::http::Status::CODE_200, "application/json").schema = root;
+      return info;
+    }));
+
+    auto config = std::make_shared<oatpp::swagger::Generator::Config>();
+    auto document = oatpp::swagger::Generator(config).generateDocument(documentInfo, endpoints);
+
+    auto schemas = document->components->schemas;
+    OATPP_ASSERT(static_cast<v_int32>(schemas->size()) == depth);
+    OATPP_ASSERT(schemas->front().first == "ChainDto0");
+    OATPP_ASSERT(schemas->front().second->properties["next"]->ref == "#/components/schemas/ChainDto1");
+    OATPP_ASSERT(schemas["ChainDto" + std::to_string(depth - 1)]->properties["next"]->ref == "#/components/schemas/ChainDto0");
+
+  }
+
+  { // hoisting of duplicate inline schemas
+
+    oatpp::web::server::api::Endpoints endpoints;
+    endpoints.list.push_back(oatpp::web::server::api::Endpoint::createShared(nullptr, []() {
+      auto info = oatpp::web::server::api::Endpoint::Info::createShared();
+      info->name = "postContact";
+      info->method = "POST";
+      info->path = "/contacts";
+      info->addConsumes<oatpp::Object<DedupContactDto>>("application/json");
+      info->addResponse<oatpp::Object<DedupAddressDto>>(oatpp::web::protocol::http::Status::CODE_200, "application/json");
+      return info;
+    }));
+
+    auto config = std::make_shared<oatpp::swagger::Generator::Config>();
+    config->deduplicateSchemas = true;
+    config->hoistDuplicateSchemas = true;
+
+    oatpp::swagger::Generator generator(config);
+    auto schemas = generator.generateDocument(documentInfo, endpoints)->components->schemas;
+    OATPP_ASSERT(schemas->size() == 3);
+
+    // The same Fields<String> shape is used three times - it becomes one component.
+    auto contact = schemas["DedupContactDto"];
+    auto address = schemas["DedupAddressDto"];
+    auto ref = contact->properties["labels"]->ref;
+    OATPP_ASSERT(ref);
+    OATPP_ASSERT(ref->find("#/components/schemas/InlineSchema_") == 0);
+    OATPP_ASSERT(contact->properties["tags"]->ref == ref);
+    OATPP_ASSERT(address->properties["labels"]->ref == ref);
+
+    auto inlineSchema = schemas[ref->substr(std::strlen("#/components/schemas/"))];
+    OATPP_ASSERT(inlineSchema);
+    OATPP_ASSERT(inlineSchema->type == "object");
+    OATPP_ASSERT(inlineSchema->additionalProperties->type == "string");
+
+    // The same shape with a description is a different schema.
+    auto notes = address->properties["notes"];
+    OATPP_ASSERT(!notes->ref);
+    OATPP_ASSERT(notes->description == "Notes");
+    OATPP_ASSERT(notes->additionalProperties->type == "string");
+
+    // Simple-type schemas shared by the generator must be unchanged by deduplication.
+    config->deduplicateSchemas = false;
+    config->enableInterpretations = {"test"};
+    auto expected = mapper->writeToString(oatpp::swagger::Generator(config).generateDocument(documentInfo, docEndpoints));
+    OATPP_ASSERT(mapper->writeToString(generator.generateDocument(documentInfo, docEndpoints)) == expected);
+
+  }
+
+  { // deduplication of schemas with different enums and of shared schemas
+
+    auto enumSchema = [](const char* a, const char* b) {
+      auto schema = oatpp::swagger::oas3::Schema::createShared();
+      schema->type = "string";
+      schema->enumValues = oatpp::List<oatpp::Any>::createShared();
+      schema->enumValues->push_back(oatpp::Any(oatpp::String(a)));
+      schema->enumValues->push_back(oatpp::Any(oatpp::String(b)));
+      return schema;
+    };
+
+    auto parameter = [](const oatpp::Object<oatpp::swagger::oas3::Schema>& schema) {
+      auto result = oatpp::swagger::oas3::PathItemParameter::createShared();
+      result->name = "p";
+      result->in = "query";
+      result->schema = schema;
+      return result;
+    };
+
+    // Schema shared outside of the document. Its items duplicate another schema of the document.
+    auto shared = oatpp::swagger::oas3::Schema::createShared();
+    shared->type = "array";
+    shared->items = enumSchema("a", "b");
+    auto sharedItems = shared->items;
+
+    auto document = oatpp::swagger::oas3::Document::createShared();
+    document->paths = oatpp::Fields<oatpp::Object<oatpp::swagger::oas3::PathItem>>::createShared();
+    for(const char* path : {"/first", "/second"}) {
+      auto pathItem = oatpp::swagger::oas3::PathItem::createShared();
+      pathItem->operationGet = oatpp::swagger::oas3::PathItemOperation::createShared();
+      pathItem->operationGet->parameters = {parameter(enumSchema("a", "b")), parameter(enumSchema("a", "c")), parameter(shared)};
+      document->paths->push_back({path, pathItem});
+    }
+
+    oatpp::swagger::Deduplicator deduplicator(true, {shared.get()});
+    deduplicator.deduplicate(document);
+    OATPP_ASSERT(deduplicator.getHoistedSchemasCount() == 3);
+    OATPP_ASSERT(document->components->schemas->size() == 3);
+
+    auto first = document->paths["/first"]->operationGet->parameters;
+    auto second = document->paths["/second"]->operationGet->parameters;
+
+    auto ab = first[0]->schema->ref;
+    auto ac = first[1]->schema->ref;
+    OATPP_ASSERT(ab && ac && ab != ac);
+    OATPP_ASSERT(second[0]->schema->ref == ab);
+    OATPP_ASSERT(second[1]->schema->ref == ac);
+
+    auto array = first[2]->schema->ref;
+    OATPP_ASSERT(array && second[2]->schema->ref == array);
+    OATPP_ASSERT(document->components->schemas[array->substr(std::strlen("#/components/schemas/"))]->items->ref == ab);
+
+    OATPP_ASSERT(!shared->ref);
+    OATPP_ASSERT(shared->items.get() == sharedItems.get());
+    OATPP_ASSERT(!sharedItems->ref && sharedItems->enumValues->size() == 2);
+
+  }
+
+  { // stats
+
+    oatpp::web::server::api::Endpoints endpoints;
+    endpoints.list.push_back(oatpp::web::server::api::Endpoint::createShared(nullptr, []() {
+      auto info = oatpp::web::server::api::Endpoint::Info::createShared();
+      info->name = "getStats";
+      info->method = "GET";
+      info->path = "/stats";
+      info->addResponse<oatpp::Object<StatsDto>>(oatpp::web::protocol::http::Status::CODE_200, "application/json");
+      return info;
+    }));
+
+    auto config = std::make_shared<oatpp::swagger::Generator::Config>();
+    oatpp::swagger::Generator generator(config);
+
+    for(v_int32 i = 0; i < 2; i++) {
+
+      generator.generateDocument(documentInfo, endpoints);
+      const auto& stats = generator.getStats();
+
+      OATPP_ASSERT(stats.endpointsCount == 1);
+      OATPP_ASSERT(stats.componentSchemasCount == 1);
+      // Only `plain` uses the shared schema as is. `described` and `withDefault` get their own copies.
+      OATPP_ASSERT(stats.schemaCacheHits == 1);
+      // $ref of the response, the StatsDto definition and the two copies.
+      OATPP_ASSERT(stats.schemasGenerated == 4);
+      OATPP_ASSERT(stats.stringsAllocated > 0);
+      OATPP_ASSERT(stats.arenaSize == 0);
+      OATPP_ASSERT(stats.serializedSize == -1);
+
+    }
+
+  }
+
+  { // compact document
+
+    auto config = std::make_shared<oatpp::swagger::Generator::Config>();
+    config->enableInterpretations = {"test"};
+    auto full = mapper->writeToString(oatpp::swagger::Generator(config).generateDocument(documentInfo, docEndpoints));
+
+    config->compact = true;
+    auto compactDocument = oatpp::swagger::Generator(config).generateDocument(documentInfo, docEndpoints);
+
+    auto compactMapper = std::make_shared<oatpp::json::ObjectMapper>();
+    compactMapper->serializerConfig().mapper.includeNullFields = false;
+    compactMapper->serializerConfig().json.escapeFlags = 0;
+    auto compact = compactMapper->writeToString(compactDocument);
+
+    OATPP_ASSERT(compact->size() < full->size());
+
+    OATPP_ASSERT(full->find("\"required\":[]") != std::string::npos);
+    OATPP_ASSERT(compact->find("\"required\":[]") == std::string::npos);
+    OATPP_ASSERT(compact->find("\"parameters\":[]") == std::string::npos);
+    OATPP_ASSERT(compact->find("\"deprecated\":false") == std::string::npos);
+    OATPP_ASSERT(compact->find("2147483647") == std::string::npos);
+    OATPP_ASSERT(compact->find("\"format\":\"int32\"") != std::string::npos);
+    OATPP_ASSERT(compact->find("\\/") == std::string::npos);
+
+    // Every operation must still have at least one response.
+    for(auto& path : *compactDocument->paths) {
+      if(path.second->operationGet) {
+        OATPP_ASSERT(path.second->operationGet->responses->size() > 0);
+      }
+    }
+
+    // Exact output for one endpoint.
+    oatpp::web::server::api::Endpoints endpoints;
+    endpoints.list.push_back(oatpp::web::server::api::Endpoint::createShared(nullptr, []() {
+      auto info = oatpp::web::server::api::Endpoint::Info::createShared();
+      info->name = "getItem";
+      info->method = "GET";
+      info->path = "/items/{id}";
+      info->pathParams.add<oatpp::String>("id").required = true;
+      auto& limit = info->queryParams.add<oatpp::Int32>("limit");
+      limit.required = false;
+      limit.deprecated = false;
+      return info;
+    }));
+
+    auto document = oatpp::swagger::Generator(config).generateDocument(documentInfo, endpoints);
+    OATPP_ASSERT(compactMapper->writeToString(document->paths) ==
+      "{\"/items/{id}\":{\"get\":{"
+        "\"operationId\":\"getItem\","
+        "\"responses\":{\"200\":{\"description\":\"success\"}},"
+        "\"parameters\":["
+          "{\"name\":\"id\",\"in\":\"path\",\"required\":true,\"schema\":{\"type\":\"string\"}},"
+          "{\"name\":\"limit\",\"in\":\"query\",\"schema\":{\"type\":\"integer\",\"format\":\"int32\"}}"
+        "]"
+      "}}}");
+
+  }
+
+  { // deterministic document
+
+    auto config = std::make_shared<oatpp::swagger::Generator::Config>();
+    config->enableInterpretations = {"test"};
+
+    oatpp::String expected;
+
+    for(v_int32 i = 0; i < 3; i++) {
+
+      oatpp::swagger::Generator generator(config);
+      auto document = generator.generateDocument(documentInfo, docEndpoints);
+
+      auto data = mapper->writeToString(document);
+      if(expected) {
+        OATPP_ASSERT(data == expected);
+      } else {
+        expected = data;
+      }
+
+      OATPP_ASSERT(document->components->schemas->size() > 1);
+      for(auto it = std::next(document->components->schemas->begin()); it != document->components->schemas->end(); ++it) {
+        OATPP_ASSERT(*std::prev(it)->first < *it->first);
+      }
+
+      OATPP_ASSERT(document->components->securitySchemes->size() == 1);
+      OATPP_ASSERT(document->components->securitySchemes->front().first == "basic_auth");
+
+    }
+
+  }
+
+  { // types with the same name
+
+    auto createEndpoint = [](const char* path, const oatpp::Type* type) {
+      return oatpp::web::server::api::Endpoint::createShared(nullptr, [path, type]() {
+        auto info = oatpp::web::server::api::Endpoint::Info::createShared();
+        info->name = path;
+        info->method = "GET";
+        info->path = path;
+        info->addResponse<oatpp::Void>(oatpp::web::protocol::http::Status::CODE_200, "application/json").schema = type;
+        return info;
+      });
+    };
+
+    auto firstType = oatpp::Object<first::SameNameDto>::Class::getType();
+    auto secondType = oatpp::Object<second::SameNameDto>::Class::getType();
+
+    // The type referenced first from the endpoints wins, whatever the hash order of the types is.
+    for(v_int32 i = 0; i < 2; i++) {
+
+      oatpp::web::server::api::Endpoints endpoints;
+      endpoints.list.push_back(createEndpoint("/a", i == 0 ? firstType : secondType));
+      endpoints.list.push_back(createEndpoint("/b", i == 0 ? secondType : firstType));
+
+      auto config = std::make_shared<oatpp::swagger::Generator::Config>();
+      for(v_int32 run = 0; run < 3; run++) {
+        auto document = oatpp::swagger::Generator(config).generateDocument(documentInfo, endpoints);
+        auto schemas = document->components->schemas;
+        OATPP_ASSERT(schemas->size() == 1);
+        auto properties = schemas["SameNameDto"]->properties;
+        OATPP_ASSERT(properties->size() == 1);
+        OATPP_ASSERT(properties->front().first == (i == 0 ? "first" : "second"));
+      }
+
+    }
+
+  }
+
+  { // string pool is per document
+
+    auto config = std::make_shared<oatpp::swagger::Generator::Config>();
+    config->enableInterpretations = {"test"};
+
+    oatpp::swagger::Generator generator(config);
+    auto first = mapper->writeToString(generator.generateDocument(documentInfo, docEndpoints));
+    auto stringsAllocated = generator.getStats().stringsAllocated;
+    OATPP_ASSERT(stringsAllocated > 0);
+
+    auto second = mapper->writeToString(generator.generateDocument(documentInfo, docEndpoints));
+    OATPP_ASSERT(second == first);
+    OATPP_ASSERT(generator.getStats().stringsAllocated == stringsAllocated);
+
+  }
+
+}
+
+}}}
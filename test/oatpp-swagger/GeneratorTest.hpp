@@ -0,0 +1,18 @@
+#ifndef OATPP_SWAGGER_GENERATORTEST_HPP
+#define OATPP_SWAGGER_GENERATORTEST_HPP
+
+#include "oatpp-test/UnitTest.hpp"
+
+namespace oatpp { namespace test { namespace swagger {
+
+class GeneratorTest : public UnitTest {
+public:
+
+  GeneratorTest():UnitTest("TEST[swagger::GeneratorTest]"){}
+  void onRun() override;
+
+};
+
+}}}
+
+#endif //OATPP_SWAGGER_GENERATORTEST_HPP
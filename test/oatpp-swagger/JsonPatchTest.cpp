@@ -0,0 +1,470 @@
+#include "JsonPatchTest.hpp"
+
+#include "oatpp-swagger/DocumentFragments.hpp"
+#include "oatpp-swagger/DocumentHistory.hpp"
+#include "oatpp-swagger/JsonPatch.hpp"
+#include "oatpp-swagger/oas3/Model.hpp"
+#include "oatpp/json/ObjectMapper.hpp"
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include OATPP_CODEGEN_BEGIN(DTO)
+
+class PatchItemDto : public oatpp::DTO {
+
+  DTO_INIT(PatchItemDto, DTO)
+
+  DTO_FIELD(String, name);
+  DTO_FIELD(Int32, count);
+
+};
+
+class PatchDocumentDto : public oatpp::DTO {
+
+  DTO_INIT(PatchDocumentDto, DTO)
+
+  DTO_FIELD(String, title);
+  DTO_FIELD(String, note);
+  DTO_FIELD(Object<PatchItemDto>, main);
+  DTO_FIELD(List<String>, tags);
+  DTO_FIELD(List<Object<PatchItemDto>>, items);
+  DTO_FIELD(Fields<String>, labels);
+  DTO_FIELD(UnorderedFields<Int32>, counters);
+
+};
+
+#include OATPP_CODEGEN_END(DTO)
+
+namespace oatpp { namespace test { namespace swagger {
+
+namespace {
+
+  /**
+   * Minimal JSON tree to apply patches to - enough for what the json mapper writes.
+   * Numbers are kept as written.
+   */
+  struct Json {
+
+    enum Kind { NUL, BOOL, NUMBER, STRING, ARRAY, OBJECT };
+
+    Kind kind = NUL;
+    std::string scalar;
+    std::vector<Json> items;
+    std::map<std::string, Json> fields;
+
+    bool operator==(const Json& other) const {
+      return kind == other.kind && scalar == other.scalar && items == other.items && fields == other.fields;
+    }
+
+  };
+
+  class JsonParser {
+  private:
+    const std::string& m_text;
+    size_t m_pos;
+  private:
+
+    void skipBlanks() {
+      while(m_pos < m_text.size() && (m_text[m_pos] == ' ' || m_text[m_pos] == '\n' || m_text[m_pos] == '\r' || m_text[m_pos] == '\t')) {
+        m_pos ++;
+      }
+    }
+
+    void expect(char c) {
+      skipBlanks();
+      OATPP_ASSERT(m_pos < m_text.size() && m_text[m_pos] == c);
+      m_pos ++;
+    }
+
+    bool consume(char c) {
+      skipBlanks();
+      if(m_pos < m_text.size() && m_text[m_pos] == c) {
+        m_pos ++;
+        return true;
+      }
+      return false;
+    }
+
+    std::string parseString() {
+      expect('"');
+      std::string result;
+      while(true) {
+        OATPP_ASSERT(m_pos < m_text.size());
+        char c = m_text[m_pos ++];
+        if(c == '"') {
+          return result;
+        }
+        if(c != '\\') {
+          result.push_back(c);
+          continue;
+        }
+        OATPP_ASSERT(m_pos < m_text.size());
+        char e = m_text[m_pos ++];
+        switch(e) {
+          case 'b': result.push_back('\b'); break;
+          case 'f': result.push_back('\f'); break;
+          case 'n': result.push_back('\n'); break;
+          case 'r': result.push_back('\r'); break;
+          case 't': result.push_back('\t'); break;
+          case 'u': {
+            OATPP_ASSERT(m_pos + 4 <= m_text.size());
+            auto code = static_cast<v_uint32>(std::stoul(m_text.substr(m_pos, 4), nullptr, 16));
+            m_pos += 4;
+            if(code < 0x80) {
+              result.push_back(static_cast<char>(code));
+            } else if(code < 0x800) {
+              result.push_back(static_cast<char>(0xC0 | (code >> 6)));
+              result.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+            } else {
+              result.push_back(static_cast<char>(0xE0 | (code >> 12)));
+              result.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+              result.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+            }
+            break;
+          }
+          default: result.push_back(e);
+        }
+      }
+    }
+
+  public:
+
+    explicit JsonParser(const std::string& text)
+      : m_text(text)
+      , m_pos(0)
+    {}
+
+    Json parse() {
+
+      Json value;
+      skipBlanks();
+      OATPP_ASSERT(m_pos < m_text.size());
+      char c = m_text[m_pos];
+
+      if(c == '{') {
+        value.kind = Json::OBJECT;
+        m_pos ++;
+        if(consume('}')) {
+          return value;
+        }
+        do {
+          skipBlanks();
+          auto key = parseString();
+          expect(':');
+          value.fields[key] = parse();
+        } while(consume(','));
+        expect('}');
+      } else if(c == '[') {
+        value.kind = Json::ARRAY;
+        m_pos ++;
+        if(consume(']')) {
+          return value;
+        }
+        do {
+          value.items.push_back(parse());
+        } while(consume(','));
+        expect(']');
+      } else if(c == '"') {
+        value.kind = Json::STRING;
+        value.scalar = parseString();
+      } else if(m_text.compare(m_pos, 4, "null") == 0) {
+        m_pos += 4;
+      } else if(m_text.compare(m_pos, 4, "true") == 0 || m_text.compare(m_pos, 5, "false") == 0) {
+        value.kind = Json::BOOL;
+        value.scalar = c == 't' ? "true" : "false";
+        m_pos += value.scalar.size();
+      } else {
+        value.kind = Json::NUMBER;
+        while(m_pos < m_text.size() && std::string("+-.eE0123456789").find(m_text[m_pos]) != std::string::npos) {
+          value.scalar.push_back(m_text[m_pos ++]);
+        }
+        OATPP_ASSERT(!value.scalar.empty());
+      }
+
+      return value;
+
+    }
+
+  };
+
+  Json parseJson(const oatpp::String& text) {
+    OATPP_ASSERT(text);
+    return JsonParser(*text).parse();
+  }
+
+  /**
+   * Apply RFC 6902 operations as produced by JsonPatch (add / remove / replace).
+   * Fails if an operation doesn't fit the document.
+   */
+  void applyPatch(Json& document, const Json& patch) {
+
+    OATPP_ASSERT(patch.kind == Json::ARRAY);
+
+    for(auto& operation : patch.items) {
+
+      auto op = operation.fields.at("op").scalar;
+
+      std::vector<std::string> tokens;
+      const auto& path = operation.fields.at("path").scalar;
+      if(path.empty()) {
+        OATPP_ASSERT(op == "replace");
+        document = operation.fields.at("value");
+        continue;
+      }
+      OATPP_ASSERT(oatpp::swagger::DocumentFragments::parsePointer(path, tokens));
+
+      Json* parent = &document;
+      for(size_t i = 0; i + 1 < tokens.size(); i++) {
+        if(parent->kind == Json::ARRAY) {
+          parent = &parent->items.at(std::stoul(tokens[i]));
+        } else {
+          OATPP_ASSERT(parent->kind == Json::OBJECT);
+          parent = &parent->fields.at(tokens[i]);
+        }
+      }
+
+      const auto& token = tokens.back();
+
+      if(parent->kind == Json::ARRAY) {
+        if(op == "add") {
+          auto index = token == "-" ? parent->items.size() : std::stoul(token);
+          OATPP_ASSERT(index <= parent->items.size());
+          parent->items.insert(parent->items.begin() + static_cast<std::ptrdiff_t>(index), operation.fields.at("value"));
+        } else {
+          auto index = std::stoul(token);
+          OATPP_ASSERT(index < parent->items.size());
+          if(op == "remove") {
+            parent->items.erase(parent->items.begin() + static_cast<std::ptrdiff_t>(index));
+          } else {
+            OATPP_ASSERT(op == "replace");
+            parent->items[index] = operation.fields.at("value");
+          }
+        }
+      } else {
+        OATPP_ASSERT(parent->kind == Json::OBJECT);
+        auto exists = parent->fields.find(token) != parent->fields.end();
+        if(op == "add") {
+          OATPP_ASSERT(!exists);
+          parent->fields[token] = operation.fields.at("value");
+        } else if(op == "remove") {
+          OATPP_ASSERT(exists);
+          parent->fields.erase(token);
+        } else {
+          OATPP_ASSERT(op == "replace" && exists);
+          parent->fields[token] = operation.fields.at("value");
+        }
+      }
+
+    }
+
+  }
+
+  /**
+   * Patch between `from` and `to` applied to serialized `from` must give serialized `to`.
+   */
+  void assertRoundTrip(const std::shared_ptr<oatpp::json::ObjectMapper>& mapper, const oatpp::Void& from, const oatpp::Void& to) {
+    auto document = parseJson(mapper->writeToString(from));
+    applyPatch(document, parseJson(oatpp::swagger::JsonPatch(mapper, from, to).toString()));
+    OATPP_ASSERT(document == parseJson(mapper->writeToString(to)));
+  }
+
+  oatpp::Object<PatchDocumentDto> createDocument() {
+    auto document = PatchDocumentDto::createShared();
+    document->title = "Patch";
+    document->note = "note";
+    document->main = PatchItemDto::createShared();
+    document->main->name = "main";
+    document->tags = {"a", "b", "c"};
+    document->items = {PatchItemDto::createShared(), PatchItemDto::createShared()};
+    document->items[0]->name = "first";
+    document->items[1]->name = "second";
+    document->items[1]->count = 2;
+    document->labels = {{"plain", "1"}, {"a/b", "2"}, {"c~d", "3"}, {"~1", "4"}};
+    document->counters = {{"x", 1}, {"y/z", 2}};
+    return document;
+  }
+
+}
+
+void JsonPatchTest::onRun() {
+
+  auto mapper = std::make_shared<oatpp::json::ObjectMapper>();
+  mapper->serializerConfig().mapper.includeNullFields = false;
+
+  auto nullsMapper = std::make_shared<oatpp::json::ObjectMapper>();
+  nullsMapper->serializerConfig().mapper.includeNullFields = true;
+
+  auto elementsMapper = std::make_shared<oatpp::json::ObjectMapper>();
+  elementsMapper->serializerConfig().mapper.includeNullFields = false;
+  elementsMapper->serializerConfig().mapper.alwaysIncludeNullCollectionElements = true;
+
+  std::vector<std::shared_ptr<oatpp::json::ObjectMapper>> mappers = {mapper, nullsMapper, elementsMapper};
+
+  { // operations
+
+    auto createDocument = [](const char* version) {
+      auto document = oatpp::swagger::oas3::Document::createShared();
+      document->info = oatpp::swagger::oas3::Info::createShared();
+      document->info->title = "Delta";
+      document->info->version = version;
+      document->paths = oatpp::Fields<oatpp::Object<oatpp::swagger::oas3::PathItem>>::createShared();
+      auto users = oatpp::swagger::oas3::PathItem::createShared();
+      users->operationGet = oatpp::swagger::oas3::PathItemOperation::createShared();
+      users->operationGet->tags = {"users"};
+      document->paths->push_back({"/users", users});
+      return document;
+    };
+
+    auto v1 = createDocument("1.0");
+    auto v2 = createDocument("2.0");
+    v2->paths->front().second->operationGet->tags->push_back("admin");
+    v2->paths->push_back({"/pets", oatpp::swagger::oas3::PathItem::createShared()});
+    v2->paths->front().second->operationGet->summary = "Users";
+
+    oatpp::swagger::JsonPatch patch(mapper, v1, v2);
+    auto text = patch.toString();
+    OATPP_ASSERT(patch.getOperationsCount() == 4);
+    OATPP_ASSERT(text->find("{\"op\":\"replace\",\"path\":\"/info/version\",\"value\":\"2.0\"}") != std::string::npos);
+    OATPP_ASSERT(text->find("{\"op\":\"add\",\"path\":\"/paths/~1users/get/summary\",\"value\":\"Users\"}") != std::string::npos);
+    OATPP_ASSERT(text->find("{\"op\":\"add\",\"path\":\"/paths/~1users/get/tags/-\",\"value\":\"admin\"}") != std::string::npos);
+    OATPP_ASSERT(text->find("{\"op\":\"add\",\"path\":\"/paths/~1pets\",\"value\":{}}") != std::string::npos);
+
+    oatpp::swagger::JsonPatch reverse(mapper, v2, v1);
+    OATPP_ASSERT(reverse.toString()->find("{\"op\":\"remove\",\"path\":\"/paths/~1pets\"}") != std::string::npos);
+    OATPP_ASSERT(reverse.toString()->find("{\"op\":\"remove\",\"path\":\"/paths/~1users/get/tags/1\"}") != std::string::npos);
+
+    OATPP_ASSERT(oatpp::swagger::JsonPatch(mapper, v1, v1).toString() == "[]");
+
+    for(auto& m : mappers) {
+      assertRoundTrip(m, v1, v2);
+      assertRoundTrip(m, v2, v1);
+    }
+  }
+
+  { // null fields
+
+    auto from = createDocument();
+    auto to = createDocument();
+    to->note = nullptr;
+    to->main = nullptr;
+
+    auto removed = oatpp::swagger::JsonPatch(mapper, from, to).toString();
+    OATPP_ASSERT(removed->find("{\"op\":\"remove\",\"path\":\"/note\"}") != std::string::npos);
+    OATPP_ASSERT(removed->find("{\"op\":\"remove\",\"path\":\"/main\"}") != std::string::npos);
+
+    auto replaced = oatpp::swagger::JsonPatch(nullsMapper, from, to).toString();
+    OATPP_ASSERT(replaced->find("{\"op\":\"replace\",\"path\":\"/note\",\"value\":null}") != std::string::npos);
+    OATPP_ASSERT(replaced->find("{\"op\":\"replace\",\"path\":\"/main\",\"value\":null}") != std::string::npos);
+
+    auto restored = oatpp::swagger::JsonPatch(nullsMapper, to, from).toString();
+    OATPP_ASSERT(restored->find("{\"op\":\"replace\",\"path\":\"/note\",\"value\":\"note\"}") != std::string::npos);
+
+    // null in both documents - nothing to patch
+    auto empty = createDocument();
+    empty->note = nullptr;
+    OATPP_ASSERT(oatpp::swagger::JsonPatch(nullsMapper, to, empty).toString()->find("/note") == std::string::npos);
+
+    for(auto& m : mappers) {
+      assertRoundTrip(m, from, to);
+      assertRoundTrip(m, to, from);
+    }
+  }
+
+  { // null collection elements
+
+    auto from = createDocument();
+    auto to = createDocument();
+    to->tags = {"a", nullptr, "c"};
+    to->labels = {{"plain", nullptr}, {"a/b", "2"}, {"c~d", "3"}, {"~1", "4"}};
+    to->items[0] = nullptr;
+
+    for(auto& m : mappers) {
+      assertRoundTrip(m, from, to);
+      assertRoundTrip(m, to, from);
+    }
+  }
+
+  { // list shrink and grow
+
+    auto from = createDocument();
+    auto to = createDocument();
+    to->tags = {"a"};
+    to->items->pop_back();
+    to->items[0]->count = 10;
+
+    OATPP_ASSERT(oatpp::swagger::JsonPatch(mapper, from, to).toString()->find("{\"op\":\"remove\",\"path\":\"/tags/2\"}") != std::string::npos);
+
+    for(auto& m : mappers) {
+      assertRoundTrip(m, from, to);
+      assertRoundTrip(m, to, from);
+    }
+
+    auto empty = createDocument();
+    empty->tags = oatpp::List<oatpp::String>::createShared();
+    empty->items = nullptr;
+    for(auto& m : mappers) {
+      assertRoundTrip(m, from, empty);
+      assertRoundTrip(m, empty, from);
+    }
+  }
+
+  { // map keys
+
+    auto from = createDocument();
+    auto to = createDocument();
+    to->labels = {{"plain", "10"}, {"a/b", "2"}, {"new~/key", "5"}};
+    to->counters = {{"x", 1}, {"w~0", 3}};
+
+    auto text = oatpp::swagger::JsonPatch(mapper, from, to).toString();
+    OATPP_ASSERT(text->find("{\"op\":\"remove\",\"path\":\"/labels/c~0d\"}") != std::string::npos);
+    OATPP_ASSERT(text->find("{\"op\":\"remove\",\"path\":\"/labels/~01\"}") != std::string::npos);
+    OATPP_ASSERT(text->find("/labels/new~0~1key") != std::string::npos);
+    OATPP_ASSERT(text->find("/counters/y~1z") != std::string::npos);
+
+    for(auto& m : mappers) {
+      assertRoundTrip(m, from, to);
+      assertRoundTrip(m, to, from);
+    }
+  }
+
+  { // document history
+
+    auto createDocument = [](const char* version) {
+      auto document = oatpp::swagger::oas3::Document::createShared();
+      document->info = oatpp::swagger::oas3::Info::createShared();
+      document->info->title = "Delta";
+      document->info->version = version;
+      return document;
+    };
+
+    auto v1 = createDocument("1.0");
+    auto v2 = createDocument("2.0");
+
+    oatpp::swagger::DocumentHistory history(mapper, 2);
+    auto d1 = std::make_shared<oatpp::swagger::DocumentCache>(mapper, v1);
+    auto d2 = std::make_shared<oatpp::swagger::DocumentCache>(mapper, v2);
+    auto d3 = std::make_shared<oatpp::swagger::DocumentCache>(mapper, createDocument("3.0"));
+
+    history.push(d1);
+    history.push(d2);
+    OATPP_ASSERT(history.getCurrentVersion() == d2->getVersion());
+    OATPP_ASSERT("\"" + *d2->getVersion() + "\"" == *d2->getETag());
+
+    auto content = history.getPatch(d1->getVersion());
+    OATPP_ASSERT(content.data == oatpp::swagger::JsonPatch(mapper, v1, v2).toString());
+    OATPP_ASSERT(content.contentType == "application/json-patch+json");
+    OATPP_ASSERT(content.headers.size() == 1 && content.headers[0].second == d2->getVersion());
+    OATPP_ASSERT(history.getPatch(d1->getVersion()).data.get() == content.data.get());
+    OATPP_ASSERT(history.getPatch(d2->getVersion()).data == "[]");
+
+    history.push(d3);
+    OATPP_ASSERT(history.getVersions().size() == 2);
+    OATPP_ASSERT(history.getPatch(d1->getVersion()).data == nullptr);
+    OATPP_ASSERT(history.getPatch(d2->getVersion()).headers[0].second == d3->getVersion());
+  }
+
+}
+
+}}}
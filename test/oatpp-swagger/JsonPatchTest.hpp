@@ -0,0 +1,19 @@
+
+#ifndef OATPP_SWAGGER_JSONPATCHTEST_HPP
+#define OATPP_SWAGGER_JSONPATCHTEST_HPP
+
+#include "oatpp-test/UnitTest.hpp"
+
+namespace oatpp { namespace test { namespace swagger {
+
+class JsonPatchTest : public UnitTest {
+public:
+
+  JsonPatchTest():UnitTest("TEST[swagger::JsonPatchTest]"){}
+  void onRun() override;
+
+};
+
+}}}
+
+#endif //OATPP_SWAGGER_JSONPATCHTEST_HPP
@@ -0,0 +1,84 @@
+#include "MetricsTest.hpp"
+
+#include "oatpp-swagger/Controller.hpp"
+#include "oatpp-swagger/Metrics.hpp"
+#include "oatpp/web/protocol/http/incoming/Request.hpp"
+#include "oatpp/json/ObjectMapper.hpp"
+
+namespace oatpp { namespace test { namespace swagger {
+
+namespace {
+
+  std::shared_ptr<oatpp::web::protocol::http::incoming::Request> createConditionalRequest(const char* path, const oatpp::String& etag) {
+    oatpp::web::protocol::http::RequestStartingLine startingLine;
+    startingLine.method = "GET";
+    startingLine.path = path;
+    startingLine.protocol = "HTTP/1.1";
+    oatpp::web::protocol::http::Headers headers;
+    headers.put("If-None-Match", etag);
+    return oatpp::web::protocol::http::incoming::Request::createShared(nullptr, startingLine, headers, nullptr, nullptr);
+  }
+
+}
+
+void MetricsTest::onRun() {
+
+  auto objectMapper = std::make_shared<oatpp::json::ObjectMapper>();
+  auto resources = oatpp::swagger::Resources::loadResources(OATPP_SWAGGER_RES_PATH);
+
+  auto document = oatpp::swagger::oas3::Document::createShared();
+  document->info = oatpp::swagger::oas3::Info::createShared();
+  document->info->title = "Metrics test";
+  document->info->version = "1.0";
+
+  auto metrics = std::make_shared<oatpp::swagger::Metrics>();
+  auto controller = std::make_shared<oatpp::swagger::Controller>(objectMapper,
+                                                                 document,
+                                                                 resources,
+                                                                 oatpp::swagger::ControllerPaths(),
+                                                                 nullptr,
+                                                                 metrics);
+
+  { // 304 sends no bytes
+
+    auto response = controller->api(nullptr);
+    OATPP_ASSERT(response->getStatus().code == 200);
+    auto bytesSent = metrics->getBytesSent();
+    OATPP_ASSERT(bytesSent == static_cast<v_int64>(controller->getState()->getDocumentCache()->getData()->size()));
+
+    auto notModified = controller->api(createConditionalRequest("/api-docs/oas-3.0.0.json", response->getHeader("ETag")));
+    OATPP_ASSERT(notModified->getStatus().code == 304);
+    OATPP_ASSERT(metrics->getRequestsCount(oatpp::swagger::Metrics::Endpoint::API) == 2);
+    OATPP_ASSERT(metrics->getNotModifiedCount() == 1);
+    OATPP_ASSERT(metrics->getBytesSent() == bytesSent);
+
+    auto resource = controller->getUIResource("index.css", nullptr);
+    bytesSent = metrics->getBytesSent();
+    notModified = controller->getUIResource("index.css", createConditionalRequest("/swagger/index.css", resource->getHeader("ETag")));
+    OATPP_ASSERT(notModified->getStatus().code == 304);
+    OATPP_ASSERT(metrics->getNotModifiedCount() == 2);
+    OATPP_ASSERT(metrics->getBytesSent() == bytesSent);
+
+  }
+
+  { // published documents update the document gauges
+
+    auto documentSize = metrics->getDocumentSize();
+    OATPP_ASSERT(documentSize == static_cast<v_int64>(controller->getState()->getDocumentCache()->getData()->size()));
+    OATPP_ASSERT(metrics->getGenerationMicros() == 0);
+
+    auto published = oatpp::swagger::oas3::Document::createShared();
+    published->info = oatpp::swagger::oas3::Info::createShared();
+    published->info->title = "Metrics test - published document";
+    published->info->version = "2.0";
+    controller->setDocument(published, 42);
+
+    OATPP_ASSERT(metrics->getDocumentSize() == static_cast<v_int64>(controller->getState()->getDocumentCache()->getData()->size()));
+    OATPP_ASSERT(metrics->getDocumentSize() > documentSize);
+    OATPP_ASSERT(metrics->getGenerationMicros() == 42);
+
+  }
+
+}
+
+}}}
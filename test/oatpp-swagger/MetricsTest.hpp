@@ -0,0 +1,19 @@
+
+#ifndef OATPP_SWAGGER_METRICSTEST_HPP
+#define OATPP_SWAGGER_METRICSTEST_HPP
+
+#include "oatpp-test/UnitTest.hpp"
+
+namespace oatpp { namespace test { namespace swagger {
+
+class MetricsTest : public UnitTest {
+public:
+
+  MetricsTest():UnitTest("TEST[swagger::MetricsTest]"){}
+  void onRun() override;
+
+};
+
+}}}
+
+#endif //OATPP_SWAGGER_METRICSTEST_HPP
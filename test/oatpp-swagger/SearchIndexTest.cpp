@@ -0,0 +1,86 @@
+#include "SearchIndexTest.hpp"
+
+#include "oatpp-swagger/Controller.hpp"
+#include "oatpp-swagger/SearchIndex.hpp"
+
+#include <string>
+#include <vector>
+
+namespace oatpp { namespace test { namespace swagger {
+
+void SearchIndexTest::onRun() {
+
+  { // search index
+
+    auto tokens = oatpp::swagger::SearchIndex::tokenize("getUserById /users/{id} HTTPServer", true);
+    std::vector<std::string> expected = {"get", "user", "by", "id", "getuserbyid", "users", "id", "http", "server", "httpserver"};
+    OATPP_ASSERT(tokens == expected);
+
+    auto document = oatpp::swagger::oas3::Document::createShared();
+    document->paths = oatpp::Fields<oatpp::Object<oatpp::swagger::oas3::PathItem>>::createShared();
+
+    auto users = oatpp::swagger::oas3::PathItem::createShared();
+    users->operationGet = oatpp::swagger::oas3::PathItemOperation::createShared();
+    users->operationGet->operationId = "getUserById";
+    users->operationGet->summary = "Get user by id";
+    users->operationGet->tags = {"users"};
+    users->operationDelete = oatpp::swagger::oas3::PathItemOperation::createShared();
+    users->operationDelete->operationId = "deleteUser";
+    document->paths->push_back({"/users/{id}", users});
+
+    auto pets = oatpp::swagger::oas3::PathItem::createShared();
+    pets->operationGet = oatpp::swagger::oas3::PathItemOperation::createShared();
+    pets->operationGet->operationId = "listPets";
+    pets->operationGet->description = "Pets of the user";
+    document->paths->push_back({"/pets", pets});
+
+    document->components = oatpp::swagger::oas3::Components::createShared();
+    document->components->schemas = {{"UserDto", oatpp::swagger::oas3::Schema::createShared()}};
+
+    oatpp::swagger::SearchIndex index(document);
+    OATPP_ASSERT(index.getTermsCount() > 0);
+
+    auto results = index.search("user", 10);
+    OATPP_ASSERT(results->size() == 4);
+    OATPP_ASSERT(results[0]->kind == "operation");
+    OATPP_ASSERT(results[0]->pointer == "/paths/~1users~1{id}/get");
+    OATPP_ASSERT(results[3]->operationId == "listPets");
+
+    results = index.search("userdto", 10);
+    OATPP_ASSERT(results->size() == 1);
+    OATPP_ASSERT(results[0]->pointer == "/components/schemas/UserDto");
+    OATPP_ASSERT(results[0]->name == "UserDto");
+
+    results = index.search("delete us", 10);
+    OATPP_ASSERT(results->size() == 1);
+    OATPP_ASSERT(results[0]->method == "DELETE");
+
+    OATPP_ASSERT(index.search("user", 1)->size() == 1);
+    OATPP_ASSERT(index.search("nothing", 10)->empty());
+    OATPP_ASSERT(index.search("", 10)->empty());
+
+  }
+
+  { // limit query parameter
+
+    typedef oatpp::swagger::Controller Controller;
+    typedef oatpp::swagger::SearchIndex SearchIndex;
+    OATPP_ASSERT(Controller::parseLimit(nullptr, SearchIndex::DEFAULT_LIMIT, SearchIndex::MAX_LIMIT) == SearchIndex::DEFAULT_LIMIT);
+    OATPP_ASSERT(Controller::parseLimit("1", SearchIndex::DEFAULT_LIMIT, SearchIndex::MAX_LIMIT) == 1);
+    OATPP_ASSERT(Controller::parseLimit("100", SearchIndex::DEFAULT_LIMIT, SearchIndex::MAX_LIMIT) == 100);
+
+    for(const char* invalid : {"0", "-1", "101", "abc", "", "2147483648"}) {
+      bool badRequest = false;
+      try {
+        Controller::parseLimit(invalid, SearchIndex::DEFAULT_LIMIT, SearchIndex::MAX_LIMIT);
+      } catch (oatpp::web::protocol::http::HttpError& e) {
+        badRequest = e.getInfo().status.code == 400;
+      }
+      OATPP_ASSERT(badRequest);
+    }
+
+  }
+
+}
+
+}}}
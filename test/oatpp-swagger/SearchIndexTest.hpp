@@ -0,0 +1,19 @@
+
+#ifndef OATPP_SWAGGER_SEARCHINDEXTEST_HPP
+#define OATPP_SWAGGER_SEARCHINDEXTEST_HPP
+
+#include "oatpp-test/UnitTest.hpp"
+
+namespace oatpp { namespace test { namespace swagger {
+
+class SearchIndexTest : public UnitTest {
+public:
+
+  SearchIndexTest():UnitTest("TEST[swagger::SearchIndexTest]"){}
+  void onRun() override;
+
+};
+
+}}}
+
+#endif //OATPP_SWAGGER_SEARCHINDEXTEST_HPP
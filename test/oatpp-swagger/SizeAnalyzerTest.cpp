@@ -0,0 +1,107 @@
+#include "SizeAnalyzerTest.hpp"
+
+#include "test-controllers/TestController.hpp"
+
+#include "oatpp-swagger/Controller.hpp"
+#include "oatpp-swagger/SizeAnalyzer.hpp"
+#include "oatpp/json/ObjectMapper.hpp"
+
+#include <iterator>
+#include <string>
+
+namespace oatpp { namespace test { namespace swagger {
+
+void SizeAnalyzerTest::onRun() {
+
+  auto objectMapper = std::make_shared<oatpp::json::ObjectMapper>();
+
+  auto mapper = std::make_shared<oatpp::json::ObjectMapper>();
+  mapper->serializerConfig().mapper.includeNullFields = false;
+
+  oatpp::swagger::DocumentInfo::Builder builder;
+  builder
+    .setTitle("Size analyzer test")
+    .setVersion("1.0")
+    .addSecurityScheme("basic_auth", oatpp::swagger::DocumentInfo::SecuritySchemeBuilder::DefaultBasicAuthorizationSecurityScheme());
+  auto documentInfo = builder.build();
+
+  oatpp::web::server::api::Endpoints docEndpoints;
+  docEndpoints.append(TestController::createShared(objectMapper)->getEndpoints());
+
+  auto config = std::make_shared<oatpp::swagger::Generator::Config>();
+  config->enableInterpretations = {"test"};
+
+  { // size analyzer
+
+    auto document = oatpp::swagger::Generator(config).generateDocument(documentInfo, docEndpoints);
+    oatpp::swagger::SizeAnalyzer analyzer(mapper, document);
+    OATPP_ASSERT(analyzer.getTotalSize() == static_cast<v_int64>(mapper->writeToString(document)->size()));
+
+    auto report = analyzer.getReport(5);
+    OATPP_ASSERT(report->paths->size() > 0 && report->paths->size() <= 5);
+    OATPP_ASSERT(report->schemas->size() > 0);
+    for(auto it = std::next(report->schemas->begin()); it != report->schemas->end(); ++it) {
+      OATPP_ASSERT(*(*std::prev(it))->size >= *(*it)->size);
+    }
+    OATPP_ASSERT(report->schemas->front()->pointer->find("/components/schemas/") == 0);
+
+    // Same inline schema in two operations - reported once, without its nested properties.
+    auto createBody = []() {
+      auto schema = oatpp::swagger::oas3::Schema::createShared();
+      schema->type = "object";
+      schema->properties = oatpp::Fields<oatpp::Object<oatpp::swagger::oas3::Schema>>::createShared();
+      for(const char* name : {"firstName", "lastName", "email", "phone"}) {
+        auto property = oatpp::swagger::oas3::Schema::createShared();
+        property->type = "string";
+        property->description = std::string("A rather long description of the property to make it big enough - ") + name;
+        schema->properties->push_back({name, property});
+      }
+      auto mediaType = oatpp::swagger::oas3::MediaTypeObject::createShared();
+      mediaType->schema = schema;
+      auto body = oatpp::swagger::oas3::RequestBody::createShared();
+      body->content = oatpp::Fields<oatpp::Object<oatpp::swagger::oas3::MediaTypeObject>>::createShared();
+      body->content->push_back({"application/json", mediaType});
+      return body;
+    };
+
+    auto duplicated = oatpp::swagger::oas3::Document::createShared();
+    duplicated->paths = oatpp::Fields<oatpp::Object<oatpp::swagger::oas3::PathItem>>::createShared();
+    for(const char* path : {"/users", "/admins"}) {
+      auto pathItem = oatpp::swagger::oas3::PathItem::createShared();
+      pathItem->operationPost = oatpp::swagger::oas3::PathItemOperation::createShared();
+      pathItem->operationPost->requestBody = createBody();
+      duplicated->paths->push_back({path, pathItem});
+    }
+
+    auto duplicatedReport = oatpp::swagger::SizeAnalyzer(mapper, duplicated).getReport();
+    OATPP_ASSERT(duplicatedReport->paths->size() == 2);
+    OATPP_ASSERT(duplicatedReport->operations->size() == 2);
+    OATPP_ASSERT(duplicatedReport->inlineSchemas->size() == 10);
+    OATPP_ASSERT(duplicatedReport->duplicates->size() == 1);
+
+    auto duplicate = duplicatedReport->duplicates->front();
+    OATPP_ASSERT(duplicate->count == 2);
+    OATPP_ASSERT(duplicate->wasted == duplicate->size);
+    OATPP_ASSERT(duplicate->pointers->front() == "/paths/~1users/post/requestBody/content/application~1json/schema");
+    OATPP_ASSERT(duplicate->pointers->back() == "/paths/~1admins/post/requestBody/content/application~1json/schema");
+
+  }
+
+  { // limit query parameter
+
+    // capped like the search limit
+    typedef oatpp::swagger::SizeAnalyzer SizeAnalyzer;
+    OATPP_ASSERT(oatpp::swagger::Controller::parseLimit("1000", SizeAnalyzer::DEFAULT_LIMIT, SizeAnalyzer::MAX_LIMIT) == 1000);
+    bool badRequest = false;
+    try {
+      oatpp::swagger::Controller::parseLimit("1001", SizeAnalyzer::DEFAULT_LIMIT, SizeAnalyzer::MAX_LIMIT);
+    } catch (oatpp::web::protocol::http::HttpError& e) {
+      badRequest = e.getInfo().status.code == 400;
+    }
+    OATPP_ASSERT(badRequest);
+
+  }
+
+}
+
+}}}
@@ -0,0 +1,19 @@
+
+#ifndef OATPP_SWAGGER_SIZEANALYZERTEST_HPP
+#define OATPP_SWAGGER_SIZEANALYZERTEST_HPP
+
+#include "oatpp-test/UnitTest.hpp"
+
+namespace oatpp { namespace test { namespace swagger {
+
+class SizeAnalyzerTest : public UnitTest {
+public:
+
+  SizeAnalyzerTest():UnitTest("TEST[swagger::SizeAnalyzerTest]"){}
+  void onRun() override;
+
+};
+
+}}}
+
+#endif //OATPP_SWAGGER_SIZEANALYZERTEST_HPP
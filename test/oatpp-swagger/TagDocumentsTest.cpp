@@ -0,0 +1,90 @@
+#include "TagDocumentsTest.hpp"
+
+#include "oatpp-swagger/TagDocuments.hpp"
+#include "oatpp-swagger/UiRenderer.hpp"
+#include "oatpp/json/ObjectMapper.hpp"
+
+namespace oatpp { namespace test { namespace swagger {
+
+void TagDocumentsTest::onRun() {
+
+  auto objectMapper = std::make_shared<oatpp::json::ObjectMapper>();
+
+  { // per-tag documents
+
+    auto schemaRef = [](const char* name) {
+      auto schema = oatpp::swagger::oas3::Schema::createShared();
+      schema->ref = oatpp::String("#/components/schemas/") + name;
+      return schema;
+    };
+
+    auto operation = [&schemaRef](const char* tag, const char* schemaName) {
+      auto op = oatpp::swagger::oas3::PathItemOperation::createShared();
+      op->tags = {tag};
+      auto mediaType = oatpp::swagger::oas3::MediaTypeObject::createShared();
+      mediaType->schema = schemaRef(schemaName);
+      auto response = oatpp::swagger::oas3::OperationResponse::createShared();
+      response->content = {{"application/json", mediaType}};
+      op->responses = {{"200", response}};
+      return op;
+    };
+
+    auto document = oatpp::swagger::oas3::Document::createShared();
+    document->paths = oatpp::Fields<oatpp::Object<oatpp::swagger::oas3::PathItem>>::createShared();
+
+    auto users = oatpp::swagger::oas3::PathItem::createShared();
+    users->operationGet = operation("users", "User");
+    document->paths->push_back({"/users", users});
+
+    auto pets = oatpp::swagger::oas3::PathItem::createShared();
+    pets->operationGet = operation("pets", "Pet");
+    pets->operationPost = oatpp::swagger::oas3::PathItemOperation::createShared();
+    document->paths->push_back({"/pets", pets});
+
+    auto user = oatpp::swagger::oas3::Schema::createShared();
+    user->properties = {{"address", schemaRef("Address")}};
+
+    document->components = oatpp::swagger::oas3::Components::createShared();
+    document->components->schemas = {
+      {"Address", oatpp::swagger::oas3::Schema::createShared()},
+      {"Pet", oatpp::swagger::oas3::Schema::createShared()},
+      {"User", user}
+    };
+
+    oatpp::swagger::TagDocuments tagDocuments(objectMapper, document);
+    OATPP_ASSERT(tagDocuments.getTags().size() == 3);
+    OATPP_ASSERT(tagDocuments.getTags()[0] == "users");
+    OATPP_ASSERT(tagDocuments.getTags()[1] == "pets");
+    OATPP_ASSERT(tagDocuments.getTags()[2] == oatpp::swagger::TagDocuments::DEFAULT_TAG);
+
+    auto usersDocument = tagDocuments.getDocument("users");
+    OATPP_ASSERT(usersDocument);
+    OATPP_ASSERT(usersDocument == tagDocuments.getDocument("users"));
+    OATPP_ASSERT(usersDocument->getDocument()->paths->size() == 1);
+    OATPP_ASSERT(usersDocument->getDocument()->components->schemas->size() == 2);
+    OATPP_ASSERT(usersDocument->getData()->find("\"Pet\"") == std::string::npos);
+
+    auto petsDocument = tagDocuments.getDocument("pets")->getDocument();
+    OATPP_ASSERT(petsDocument->paths->size() == 1);
+    OATPP_ASSERT(petsDocument->paths->front().second->operationPost == nullptr);
+    OATPP_ASSERT(petsDocument->components->schemas->size() == 1);
+
+    auto defaultDocument = tagDocuments.getDocument(oatpp::swagger::TagDocuments::DEFAULT_TAG)->getDocument();
+    OATPP_ASSERT(defaultDocument->paths->size() == 1);
+    OATPP_ASSERT(defaultDocument->paths->front().second->operationGet == nullptr);
+    OATPP_ASSERT(defaultDocument->components->schemas->empty());
+
+    OATPP_ASSERT(tagDocuments.getDocument("unknown") == nullptr);
+
+    oatpp::swagger::ControllerPaths paths;
+    oatpp::swagger::ControllerConfig config;
+    config.splitByTag = true;
+    auto resources = oatpp::swagger::Resources::loadResources(OATPP_SWAGGER_RES_PATH);
+    auto initializer = oatpp::swagger::UiRenderer::renderInitializer(*resources, paths, config, nullptr, tagDocuments.getTags());
+    OATPP_ASSERT(initializer->find("urls: [{url: \"/api-docs/oas-3.0.0/tags/users\", name: \"users\"}") != std::string::npos);
+
+  }
+
+}
+
+}}}
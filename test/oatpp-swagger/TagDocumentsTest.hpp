@@ -0,0 +1,19 @@
+
+#ifndef OATPP_SWAGGER_TAGDOCUMENTSTEST_HPP
+#define OATPP_SWAGGER_TAGDOCUMENTSTEST_HPP
+
+#include "oatpp-test/UnitTest.hpp"
+
+namespace oatpp { namespace test { namespace swagger {
+
+class TagDocumentsTest : public UnitTest {
+public:
+
+  TagDocumentsTest():UnitTest("TEST[swagger::TagDocumentsTest]"){}
+  void onRun() override;
+
+};
+
+}}}
+
+#endif //OATPP_SWAGGER_TAGDOCUMENTSTEST_HPP
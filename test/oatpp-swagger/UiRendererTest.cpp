@@ -0,0 +1,82 @@
+#include "UiRendererTest.hpp"
+
+#include "oatpp-swagger/UiRenderer.hpp"
+#include "oatpp-swagger/ResponseFactory.hpp"
+
+namespace oatpp { namespace test { namespace swagger {
+
+void UiRendererTest::onRun() {
+
+  auto resources = oatpp::swagger::Resources::loadResources(OATPP_SWAGGER_RES_PATH);
+
+  { // initializer and index
+
+    oatpp::swagger::ControllerPaths paths;
+    oatpp::swagger::ControllerConfig config;
+
+    auto initializer = oatpp::swagger::UiRenderer::renderInitializer(*resources, paths, config, "{\"openapi\":\"3.0.0\"}");
+    OATPP_ASSERT(initializer->find("url: \"/" + *paths.apiJson + "\"") != std::string::npos);
+    OATPP_ASSERT(oatpp::swagger::UiRenderer::renderIndex(*resources, paths, config, initializer) == nullptr);
+
+    config.inlineSpec = true;
+    initializer = oatpp::swagger::UiRenderer::renderInitializer(*resources, paths, config, "{\"openapi\":\"3.0.0\"}");
+    OATPP_ASSERT(initializer->find("spec: {\"openapi\":\"3.0.0\"}") != std::string::npos);
+    OATPP_ASSERT(initializer->find("%%API.JSON%%") == std::string::npos);
+
+    config.inlineSpec = false;
+    config.preloadSpec = true;
+    auto index = oatpp::swagger::UiRenderer::renderIndex(*resources, paths, config, initializer);
+    OATPP_ASSERT(index);
+    OATPP_ASSERT(index->find("rel=\"preload\" href=\"/" + *paths.apiJson + "\"") != std::string::npos);
+
+  }
+
+  { // inline small assets and preload links
+
+    oatpp::swagger::ControllerPaths paths;
+    oatpp::swagger::ControllerConfig config;
+    config.inlineSmallAssets = true;
+
+    auto initializer = oatpp::swagger::UiRenderer::renderInitializer(*resources, paths, config, nullptr);
+    auto index = oatpp::swagger::UiRenderer::renderIndex(*resources, paths, config, initializer);
+    OATPP_ASSERT(index);
+    OATPP_ASSERT(index->find("href=\"index.css\"") == std::string::npos);
+    OATPP_ASSERT(index->find("<style>") != std::string::npos);
+    OATPP_ASSERT(index->find("href=\"data:image/png;base64,") != std::string::npos);
+    OATPP_ASSERT(index->find("src=\"./swagger-initializer.js\"") == std::string::npos);
+    OATPP_ASSERT(index->find("src=\"./swagger-ui-bundle.js\"") != std::string::npos);
+
+    OATPP_ASSERT(oatpp::swagger::UiRenderer::renderPreloadLinks(*resources, paths, config, index) == nullptr);
+
+    config.preloadAssets = true;
+    auto links = oatpp::swagger::UiRenderer::renderPreloadLinks(*resources, paths, config, index);
+    OATPP_ASSERT(links);
+    OATPP_ASSERT(links->find("swagger-ui-bundle.js>; rel=preload; as=script") != std::string::npos);
+    OATPP_ASSERT(links->find("swagger-ui.css>; rel=preload; as=style") != std::string::npos);
+    OATPP_ASSERT(links->find("index.css") == std::string::npos);
+    OATPP_ASSERT(links->find("swagger-initializer.js") == std::string::npos);
+
+    oatpp::swagger::ResponseFactory::Content content = oatpp::swagger::ResponseFactory::createContent(index, "text/html");
+    content.headers.push_back({"Link", links});
+    auto response = oatpp::swagger::ResponseFactory::createContentResponse(nullptr, content);
+    OATPP_ASSERT(response->getHeader("Link") == links);
+    response = oatpp::swagger::ResponseFactory::createContentHeadResponse(nullptr, content);
+    OATPP_ASSERT(response->getHeader("Link") == links);
+
+  }
+
+  { // inlined spec is script-safe
+
+    // The compact document is serialized without escaping `/` - it must stay safe to inline into a <script>.
+    oatpp::swagger::ControllerConfig controllerConfig;
+    controllerConfig.inlineSpec = true;
+    oatpp::swagger::ControllerPaths paths;
+    auto initializer = oatpp::swagger::UiRenderer::renderInitializer(*resources, paths, controllerConfig, "{\"info\":{\"description\":\"</script>\"}}");
+    OATPP_ASSERT(initializer->find("</script>") == std::string::npos);
+    OATPP_ASSERT(initializer->find("<\\/script>") != std::string::npos);
+
+  }
+
+}
+
+}}}
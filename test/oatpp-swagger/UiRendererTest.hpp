@@ -0,0 +1,19 @@
+
+#ifndef OATPP_SWAGGER_UIRENDERERTEST_HPP
+#define OATPP_SWAGGER_UIRENDERERTEST_HPP
+
+#include "oatpp-test/UnitTest.hpp"
+
+namespace oatpp { namespace test { namespace swagger {
+
+class UiRendererTest : public UnitTest {
+public:
+
+  UiRendererTest():UnitTest("TEST[swagger::UiRendererTest]"){}
+  void onRun() override;
+
+};
+
+}}}
+
+#endif //OATPP_SWAGGER_UIRENDERERTEST_HPP
@@ -0,0 +1,515 @@
+//
+// Generator micro-benchmark.
+// Generates synthetic endpoints and DTO graphs of configurable scale and measures
+// Generator::generateDocument(). Time of each phase is taken from Generator::Stats of the same run.
+//
+// Usage:
+//   generator-benchmark [--endpoints N] [--dtos N] [--fields N] [--depth N] [--enum-size 4|16|64] [--iterations N]
+//
+
+#include "oatpp-swagger/Generator.hpp"
+
+#include "oatpp/json/ObjectMapper.hpp"
+#include "oatpp/macro/codegen.hpp"
+#include "oatpp/Environment.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Allocation counting //-------------------------------------------------------------
+
+namespace {
+  std::atomic<v_int64> g_allocations(0);
+  std::atomic<v_int64> g_allocatedBytes(0);
+}
+
+void* operator new(std::size_t size) {
+  g_allocations.fetch_add(1, std::memory_order_relaxed);
+  g_allocatedBytes.fetch_add(static_cast<v_int64>(size), std::memory_order_relaxed);
+  void* ptr = std::malloc(size == 0 ? 1 : size);
+  if(ptr == nullptr) {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+
+void operator delete(void* ptr) noexcept {
+  std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t /* size */) noexcept {
+  std::free(ptr);
+}
+
+// Enums //---------------------------------------------------------------------------
+
+#include OATPP_CODEGEN_BEGIN(DTO)
+
+ENUM(BenchEnum4, v_int32,
+     VALUE(V0, 0, "value-0"),
+     VALUE(V1, 1, "value-1"),
+     VALUE(V2, 2, "value-2"),
+     VALUE(V3, 3, "value-3")
+)
+
+ENUM(BenchEnum16, v_int32,
+     VALUE(V0, 0, "value-0"),
+     VALUE(V1, 1, "value-1"),
+     VALUE(V2, 2, "value-2"),
+     VALUE(V3, 3, "value-3"),
+     VALUE(V4, 4, "value-4"),
+     VALUE(V5, 5, "value-5"),
+     VALUE(V6, 6, "value-6"),
+     VALUE(V7, 7, "value-7"),
+     VALUE(V8, 8, "value-8"),
+     VALUE(V9, 9, "value-9"),
+     VALUE(V10, 10, "value-10"),
+     VALUE(V11, 11, "value-11"),
+     VALUE(V12, 12, "value-12"),
+     VALUE(V13, 13, "value-13"),
+     VALUE(V14, 14, "value-14"),
+     VALUE(V15, 15, "value-15")
+)
+
+ENUM(BenchEnum64, v_int32,
+     VALUE(V0, 0, "value-0"),
+     VALUE(V1, 1, "value-1"),
+     VALUE(V2, 2, "value-2"),
+     VALUE(V3, 3, "value-3"),
+     VALUE(V4, 4, "value-4"),
+     VALUE(V5, 5, "value-5"),
+     VALUE(V6, 6, "value-6"),
+     VALUE(V7, 7, "value-7"),
+     VALUE(V8, 8, "value-8"),
+     VALUE(V9, 9, "value-9"),
+     VALUE(V10, 10, "value-10"),
+     VALUE(V11, 11, "value-11"),
+     VALUE(V12, 12, "value-12"),
+     VALUE(V13, 13, "value-13"),
+     VALUE(V14, 14, "value-14"),
+     VALUE(V15, 15, "value-15"),
+     VALUE(V16, 16, "value-16"),
+     VALUE(V17, 17, "value-17"),
+     VALUE(V18, 18, "value-18"),
+     VALUE(V19, 19, "value-19"),
+     VALUE(V20, 20, "value-20"),
+     VALUE(V21, 21, "value-21"),
+     VALUE(V22, 22, "value-22"),
+     VALUE(V23, 23, "value-23"),
+     VALUE(V24, 24, "value-24"),
+     VALUE(V25, 25, "value-25"),
+     VALUE(V26, 26, "value-26"),
+     VALUE(V27, 27, "value-27"),
+     VALUE(V28, 28, "value-28"),
+     VALUE(V29, 29, "value-29"),
+     VALUE(V30, 30, "value-30"),
+     VALUE(V31, 31, "value-31"),
+     VALUE(V32, 32, "value-32"),
+     VALUE(V33, 33, "value-33"),
+     VALUE(V34, 34, "value-34"),
+     VALUE(V35, 35, "value-35"),
+     VALUE(V36, 36, "value-36"),
+     VALUE(V37, 37, "value-37"),
+     VALUE(V38, 38, "value-38"),
+     VALUE(V39, 39, "value-39"),
+     VALUE(V40, 40, "value-40"),
+     VALUE(V41, 41, "value-41"),
+     VALUE(V42, 42, "value-42"),
+     VALUE(V43, 43, "value-43"),
+     VALUE(V44, 44, "value-44"),
+     VALUE(V45, 45, "value-45"),
+     VALUE(V46, 46, "value-46"),
+     VALUE(V47, 47, "value-47"),
+     VALUE(V48, 48, "value-48"),
+     VALUE(V49, 49, "value-49"),
+     VALUE(V50, 50, "value-50"),
+     VALUE(V51, 51, "value-51"),
+     VALUE(V52, 52, "value-52"),
+     VALUE(V53, 53, "value-53"),
+     VALUE(V54, 54, "value-54"),
+     VALUE(V55, 55, "value-55"),
+     VALUE(V56, 56, "value-56"),
+     VALUE(V57, 57, "value-57"),
+     VALUE(V58, 58, "value-58"),
+     VALUE(V59, 59, "value-59"),
+     VALUE(V60, 60, "value-60"),
+     VALUE(V61, 61, "value-61"),
+     VALUE(V62, 62, "value-62"),
+     VALUE(V63, 63, "value-63")
+)
+
+#include OATPP_CODEGEN_END(DTO)
+
+namespace oatpp { namespace test { namespace swagger { namespace benchmark {
+
+// Synthetic DTOs //------------------------------------------------------------------
+
+/**
+ * Storage for DTO fields of synthetic types.
+ */
+class SyntheticObject : public oatpp::BaseObject {
+public:
+  static constexpr v_int32 MAX_FIELDS = 256;
+public:
+  oatpp::Void fields[MAX_FIELDS];
+};
+
+class SyntheticObjectDispatcher : public oatpp::data::type::__class::AbstractObject::PolymorphicDispatcher {
+public:
+  const oatpp::Type* type = nullptr;
+  oatpp::BaseObject::Properties properties;
+public:
+
+  oatpp::Void createObject() const override {
+    return oatpp::Void(std::make_shared<SyntheticObject>(), type);
+  }
+
+  const oatpp::BaseObject::Properties* getProperties() const override {
+    return &properties;
+  }
+
+};
+
+struct Scale {
+  v_int32 endpoints = 1000;
+  v_int32 dtos = 500;
+  v_int32 fields = 12;
+  v_int32 depth = 5;
+  v_int32 enumSize = 16;
+  v_int32 iterations = 10;
+};
+
+/**
+ * Synthetic API - runtime-built DTO types and endpoints.
+ */
+class SyntheticApi {
+private:
+  std::vector<std::unique_ptr<std::string>> m_names;
+  std::vector<std::unique_ptr<SyntheticObjectDispatcher>> m_dispatchers;
+  std::vector<std::unique_ptr<oatpp::BaseObject::Property>> m_properties;
+  std::vector<std::unique_ptr<oatpp::Type>> m_types;
+  std::vector<const oatpp::Type*> m_dtos;
+  v_int64 m_fieldOffsets[SyntheticObject::MAX_FIELDS];
+private:
+
+  const char* keepName(const std::string& name) {
+    m_names.push_back(std::make_unique<std::string>(name));
+    return m_names.back()->c_str();
+  }
+
+  const oatpp::Type* createContainerType(const oatpp::ClassId& classId, std::vector<const oatpp::Type*>&& params) {
+    oatpp::Type::Info info;
+    info.params = std::move(params);
+    m_types.push_back(std::make_unique<oatpp::Type>(classId, info));
+    return m_types.back().get();
+  }
+
+  const oatpp::Type* getEnumType(v_int32 size) {
+    switch(size) {
+      case 4: return oatpp::Enum<BenchEnum4>::Class::getType();
+      case 16: return oatpp::Enum<BenchEnum16>::Class::getType();
+      case 64: return oatpp::Enum<BenchEnum64>::Class::getType();
+      default:
+        throw std::runtime_error("[oatpp::test::swagger::benchmark::SyntheticApi::getEnumType()]: Error. Unsupported enum size.");
+    }
+  }
+
+  const oatpp::Type* getPrimitiveType(v_int32 index) {
+    switch(index % 6) {
+      case 0: return oatpp::String::Class::getType();
+      case 1: return oatpp::Int32::Class::getType();
+      case 2: return oatpp::Int64::Class::getType();
+      case 3: return oatpp::Boolean::Class::getType();
+      case 4: return oatpp::Float64::Class::getType();
+      default: return oatpp::UInt8::Class::getType();
+    }
+  }
+
+public:
+
+  Scale scale;
+  oatpp::web::server::api::Endpoints endpoints;
+
+public:
+
+  explicit SyntheticApi(const Scale& pScale)
+    : scale(pScale)
+  {
+
+    SyntheticObject sample;
+    for(v_int32 i = 0; i < SyntheticObject::MAX_FIELDS; i++) {
+      m_fieldOffsets[i] = reinterpret_cast<v_int64>(&sample.fields[i]) - reinterpret_cast<v_int64>(static_cast<oatpp::BaseObject*>(&sample));
+    }
+
+    if(scale.fields > SyntheticObject::MAX_FIELDS) scale.fields = SyntheticObject::MAX_FIELDS;
+    if(scale.depth < 1) scale.depth = 1;
+
+    // Create types first - fields may reference DTOs created later.
+    for(v_int32 i = 0; i < scale.dtos; i++) {
+      auto dispatcher = std::make_unique<SyntheticObjectDispatcher>();
+      oatpp::Type::Info info;
+      info.nameQualifier = keepName("SyntheticDto" + std::to_string(i));
+      info.polymorphicDispatcher = dispatcher.get();
+      m_types.push_back(std::make_unique<oatpp::Type>(oatpp::data::type::__class::AbstractObject::CLASS_ID, info));
+      dispatcher->type = m_types.back().get();
+      m_dtos.push_back(m_types.back().get());
+      m_dispatchers.push_back(std::move(dispatcher));
+    }
+
+    // DTOs form chains of `depth` length. Each DTO references the next one in its chain.
+    for(v_int32 i = 0; i < scale.dtos; i++) {
+
+      auto& properties = m_dispatchers[i]->properties;
+
+      for(v_int32 f = 0; f < scale.fields; f++) {
+
+        const oatpp::Type* fieldType;
+        bool hasChild = (i % scale.depth) != scale.depth - 1 && i + 1 < scale.dtos;
+
+        if(f == 0 && hasChild) {
+          fieldType = m_dtos[i + 1];
+        } else if(f == 1 && hasChild) {
+          fieldType = createContainerType(oatpp::data::type::__class::AbstractList::CLASS_ID, {m_dtos[i + 1]});
+        } else if(f == 2 && hasChild) {
+          fieldType = createContainerType(oatpp::data::type::__class::AbstractPairList::CLASS_ID,
+                                          {oatpp::String::Class::getType(), m_dtos[i + 1]});
+        } else if(f == 3) {
+          fieldType = getEnumType(scale.enumSize);
+        } else if(f == 4) {
+          fieldType = createContainerType(oatpp::data::type::__class::AbstractList::CLASS_ID, {oatpp::String::Class::getType()});
+        } else {
+          fieldType = getPrimitiveType(f);
+        }
+
+        m_properties.push_back(std::make_unique<oatpp::BaseObject::Property>(
+          m_fieldOffsets[f], keepName("field" + std::to_string(f)), fieldType
+        ));
+        auto property = m_properties.back().get();
+        if(f % 3 == 0) {
+          property->info.description = "Synthetic field number " + std::to_string(f);
+        }
+        property->info.required = (f % 2 == 0);
+        properties.pushBack(property);
+
+      }
+
+    }
+
+    // Endpoints. Each endpoint uses roots of DTO chains for its request and response bodies.
+    v_int32 chains = (scale.dtos + scale.depth - 1) / scale.depth;
+    for(v_int32 e = 0; e < scale.endpoints; e++) {
+
+      auto responseDto = chains > 0 ? m_dtos[(e % chains) * scale.depth] : nullptr;
+      auto requestDto = chains > 0 ? m_dtos[((e + 1) % chains) * scale.depth] : nullptr;
+      auto index = std::to_string(e);
+      auto method = e % 2 == 0 ? "GET" : "POST";
+
+      auto infoBuilder = [index, method, responseDto, requestDto]() {
+        auto info = oatpp::web::server::api::Endpoint::Info::createShared();
+        info->name = "operation" + index;
+        info->method = method;
+        info->path = "/api/resource" + index + "/{id}";
+        info->summary = "Synthetic operation " + index;
+        info->tags.push_back("tag" + std::to_string(std::stoi(index) % 20));
+        info->pathParams.add("id", oatpp::Int64::Class::getType());
+        info->queryParams.add("filter", oatpp::String::Class::getType()).required = false;
+        info->headers.add("X-Request-Id", oatpp::String::Class::getType());
+        if(responseDto) {
+          info->addResponse<oatpp::Void>(oatpp::web::protocol::http::Status::CODE_200, "application/json").schema = responseDto;
+        }
+        info->addResponse<oatpp::String>(oatpp::web::protocol::http::Status::CODE_404, "text/plain");
+        if(requestDto && std::string(method) == "POST") {
+          info->addConsumes<oatpp::Void>("application/json").schema = requestDto;
+        }
+        return info;
+      };
+
+      endpoints.list.push_back(oatpp::web::server::api::Endpoint::createShared(nullptr, infoBuilder));
+
+    }
+
+  }
+
+};
+
+// Benchmark //-----------------------------------------------------------------------
+
+struct Measurement {
+
+  const char* name;
+  v_int64 micros = 0;
+  v_int64 allocations = 0;
+  v_int64 bytes = 0;
+
+  template<class F>
+  void run(const F& f) {
+    auto allocations0 = g_allocations.load();
+    auto bytes0 = g_allocatedBytes.load();
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto end = std::chrono::steady_clock::now();
+    micros += std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+    allocations += g_allocations.load() - allocations0;
+    bytes += g_allocatedBytes.load() - bytes0;
+  }
+
+  void print(v_int32 iterations) const {
+    std::printf("%-22s %12.1f us %14lld allocs %16lld bytes\n",
+                name,
+                static_cast<double>(micros) / iterations,
+                static_cast<long long>(allocations / iterations),
+                static_cast<long long>(bytes / iterations));
+  }
+
+};
+
+/**
+ * Phase of Generator::generateDocument() as reported by Generator::Stats.
+ */
+struct Phase {
+
+  const char* name;
+  v_int64 micros = 0;
+
+  void print(v_int32 iterations) const {
+    std::printf("  %-20s %12.1f us\n", name, static_cast<double>(micros) / iterations);
+  }
+
+};
+
+void runBenchmark(const Scale& scale, const std::shared_ptr<oatpp::swagger::Generator::Config>& config, const char* label) {
+
+  SyntheticApi api(scale);
+
+  auto docInfo = oatpp::swagger::DocumentInfo::Builder()
+    .setTitle("Synthetic API")
+    .setVersion("1.0")
+    .build();
+
+  // Warm up endpoint infos - they are built lazily by the endpoints.
+  for(auto& endpoint : api.endpoints.list) {
+    endpoint->info();
+  }
+
+  Measurement total{"generateDocument"};
+  Phase paths{"paths"};
+  Phase decompose{"decomposition"};
+  Phase components{"components"};
+  Phase securitySchemes{"securitySchemes"};
+  Phase deduplication{"deduplication"};
+
+  v_int64 schemasCount = 0;
+  v_int64 serializedSize = 0;
+  oatpp::swagger::Generator::Stats stats;
+
+  for(v_int32 i = 0; i < api.scale.iterations; i++) {
+
+    oatpp::swagger::Generator generator(config);
+    oatpp::Object<oatpp::swagger::oas3::Document> document;
+    total.run([&] { document = generator.generateDocument(docInfo, api.endpoints); });
+    schemasCount = static_cast<v_int64>(document->components->schemas->size());
+
+    const auto& runStats = generator.getStats();
+    paths.micros += runStats.pathsMicros;
+    decompose.micros += runStats.decompositionMicros;
+    components.micros += runStats.componentsMicros;
+    securitySchemes.micros += runStats.securitySchemesMicros;
+    deduplication.micros += runStats.deduplicationMicros;
+
+    if(i == 0) {
+      oatpp::json::ObjectMapper mapper;
+      mapper.serializerConfig().mapper.includeNullFields = false;
+      serializedSize = static_cast<v_int64>(mapper.writeToString(document)->size());
+      stats = runStats;
+    }
+
+  }
+
+  std::printf("\n[%s] endpoints=%d, dtos=%d, fields=%d, depth=%d, enum-size=%d, iterations=%d\n",
+              label, api.scale.endpoints, api.scale.dtos, api.scale.fields, api.scale.depth, api.scale.enumSize, api.scale.iterations);
+  std::printf("component schemas=%lld, serialized size=%lld bytes\n",
+              static_cast<long long>(schemasCount), static_cast<long long>(serializedSize));
+  std::printf("schemas generated=%lld, schema cache hits=%lld, strings allocated=%lld, string cache hits=%lld\n",
+              static_cast<long long>(stats.schemasGenerated), static_cast<long long>(stats.schemaCacheHits),
+              static_cast<long long>(stats.stringsAllocated), static_cast<long long>(stats.stringCacheHits));
+
+  total.print(api.scale.iterations);
+  paths.print(api.scale.iterations);
+  decompose.print(api.scale.iterations);
+  components.print(api.scale.iterations);
+  securitySchemes.print(api.scale.iterations);
+  deduplication.print(api.scale.iterations);
+
+}
+
+bool parseScale(int argc, const char* argv[], Scale& scale) {
+
+  for(int i = 1; i + 1 < argc; i += 2) {
+    const char* key = argv[i];
+    v_int32 value = std::atoi(argv[i + 1]);
+    if(std::strcmp(key, "--endpoints") == 0) scale.endpoints = value;
+    else if(std::strcmp(key, "--dtos") == 0) scale.dtos = value;
+    else if(std::strcmp(key, "--fields") == 0) scale.fields = value;
+    else if(std::strcmp(key, "--depth") == 0) scale.depth = value;
+    else if(std::strcmp(key, "--enum-size") == 0) scale.enumSize = value;
+    else if(std::strcmp(key, "--iterations") == 0) scale.iterations = value;
+    else {
+      std::cerr << "Unknown option '" << key << "'\n";
+      return false;
+    }
+  }
+
+  if(scale.enumSize != 4 && scale.enumSize != 16 && scale.enumSize != 64) {
+    std::cerr << "Unsupported --enum-size " << scale.enumSize << ". Supported values are 4, 16 and 64\n";
+    return false;
+  }
+
+  if(scale.iterations < 1) scale.iterations = 1;
+  if(scale.fields < 5) scale.fields = 5;
+
+  return true;
+
+}
+
+}}}}
+
+int main(int argc, const char* argv[]) {
+
+  using namespace oatpp::test::swagger::benchmark;
+
+  Scale scale;
+  if(!parseScale(argc, argv, scale)) {
+    return 1;
+  }
+
+  oatpp::Environment::init();
+
+  {
+
+    auto defaultConfig = std::make_shared<oatpp::swagger::Generator::Config>();
+    runBenchmark(scale, defaultConfig, "default");
+
+    auto arenaConfig = std::make_shared<oatpp::swagger::Generator::Config>();
+    arenaConfig->useArena = true;
+    runBenchmark(scale, arenaConfig, "arena");
+
+    auto dedupConfig = std::make_shared<oatpp::swagger::Generator::Config>();
+    dedupConfig->deduplicateSchemas = true;
+    runBenchmark(scale, dedupConfig, "deduplicate");
+
+  }
+
+  oatpp::Environment::destroy();
+
+  return 0;
+
+}
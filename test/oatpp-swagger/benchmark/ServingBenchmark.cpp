@@ -0,0 +1,312 @@
+//
+// Serving benchmark.
+// Starts swagger Controller / AsyncController on a loopback server and drives it with
+// in-process oatpp clients. Reports RPS and p50/p99 latency per endpoint for in-memory
+// and streaming Resources.
+//
+// Usage:
+//   serving-benchmark [--concurrency N] [--requests N] [--threads N] [--port N]
+//
+//   --concurrency - number of client threads. Each thread keeps its own keep-alive connection.
+//   --requests    - number of requests per client thread per endpoint.
+//   --threads     - number of async executor processor threads (AsyncController only).
+//   --port        - loopback port to run the server on.
+//
+
+#include "oatpp-swagger/test-controllers/TestController.hpp"
+
+#include "oatpp-swagger/Controller.hpp"
+#include "oatpp-swagger/AsyncController.hpp"
+
+#include "oatpp/web/server/HttpConnectionHandler.hpp"
+#include "oatpp/web/server/AsyncHttpConnectionHandler.hpp"
+#include "oatpp/web/server/HttpRouter.hpp"
+#include "oatpp/web/client/HttpRequestExecutor.hpp"
+
+#include "oatpp/network/tcp/server/ConnectionProvider.hpp"
+#include "oatpp/network/tcp/client/ConnectionProvider.hpp"
+#include "oatpp/network/Server.hpp"
+
+#include "oatpp/async/Executor.hpp"
+#include "oatpp/Environment.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace oatpp { namespace test { namespace swagger { namespace benchmark {
+
+struct Options {
+  v_int32 concurrency = 8;
+  v_int32 requests = 200;
+  v_int32 threads = 4;
+  v_uint16 port = 8111;
+};
+
+struct Target {
+  const char* name;
+  oatpp::String path;
+};
+
+struct Result {
+  v_int64 requests = 0;
+  v_int64 errors = 0;
+  v_int64 bytes = 0;
+  v_int64 wallMicros = 0;
+  std::vector<v_int64> latencies;
+};
+
+class SwaggerComponents {
+public:
+
+  OATPP_CREATE_COMPONENT(std::shared_ptr<oatpp::swagger::DocumentInfo>, swaggerDocumentInfo)([] {
+    oatpp::swagger::DocumentInfo::Builder builder;
+    builder
+      .setTitle("Serving benchmark")
+      .setVersion("1.0")
+      .addServer("http://localhost:8000", "server on localhost")
+      .addSecurityScheme("basic_auth", oatpp::swagger::DocumentInfo::SecuritySchemeBuilder::DefaultBasicAuthorizationSecurityScheme());
+    return builder.build();
+  }());
+
+  OATPP_CREATE_COMPONENT(std::shared_ptr<oatpp::swagger::Generator::Config>, generatorConfig)([] {
+    auto config = std::make_shared<oatpp::swagger::Generator::Config>();
+    config->enableInterpretations = {"test"};
+    return config;
+  }());
+
+};
+
+/*
+ * Run `requests` requests per client thread against the target and collect latencies of successful requests.
+ */
+Result runTarget(const Options& options, const Target& target) {
+
+  auto clientProvider = oatpp::network::tcp::client::ConnectionProvider::createShared(
+    {"127.0.0.1", options.port, oatpp::network::Address::IP_4}
+  );
+  auto executor = oatpp::web::client::HttpRequestExecutor::createShared(clientProvider);
+
+  std::vector<Result> partial(static_cast<size_t>(options.concurrency));
+  std::vector<std::thread> clients;
+
+  auto start = std::chrono::steady_clock::now();
+
+  for(v_int32 c = 0; c < options.concurrency; c++) {
+    clients.emplace_back([&options, &target, &executor, &partial, c] {
+
+      Result& result = partial[static_cast<size_t>(c)];
+      result.latencies.reserve(static_cast<size_t>(options.requests));
+
+      std::shared_ptr<oatpp::web::client::RequestExecutor::ConnectionHandle> connection;
+
+      for(v_int32 i = 0; i < options.requests; i++) {
+        auto requestStart = std::chrono::steady_clock::now();
+        try {
+          if(!connection) {
+            connection = executor->getConnection();
+          }
+          auto response = executor->execute("GET", target.path, {}, nullptr, connection);
+          auto body = response->readBodyToString();
+          if(response->getStatusCode() != 200 || !body) {
+            result.errors ++;
+            connection.reset();
+            continue;
+          }
+          result.bytes += static_cast<v_int64>(body->size());
+        } catch (std::exception&) {
+          result.errors ++;
+          connection.reset();
+          continue;
+        }
+        auto requestEnd = std::chrono::steady_clock::now();
+        result.latencies.push_back(std::chrono::duration_cast<std::chrono::microseconds>(requestEnd - requestStart).count());
+        result.requests ++;
+      }
+
+    });
+  }
+
+  for(auto& client : clients) {
+    client.join();
+  }
+
+  Result total;
+  total.wallMicros = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+  for(auto& result : partial) {
+    total.requests += result.requests;
+    total.errors += result.errors;
+    total.bytes += result.bytes;
+    total.latencies.insert(total.latencies.end(), result.latencies.begin(), result.latencies.end());
+  }
+
+  std::sort(total.latencies.begin(), total.latencies.end());
+
+  return total;
+
+}
+
+v_int64 getPercentile(const std::vector<v_int64>& sorted, v_int32 percent) {
+  if(sorted.empty()) {
+    return 0;
+  }
+  auto index = (sorted.size() - 1) * static_cast<size_t>(percent) / 100;
+  return sorted[index];
+}
+
+void printResult(const Target& target, const Result& result) {
+  double seconds = static_cast<double>(result.wallMicros) / 1000000.0;
+  double rps = seconds > 0 ? static_cast<double>(result.requests) / seconds : 0;
+  double mbps = seconds > 0 ? static_cast<double>(result.bytes) / seconds / (1024 * 1024) : 0;
+  std::printf("%-26s %10.1f rps %10lld us p50 %10lld us p99 %10.1f MB/s %6lld errors\n",
+              target.name, rps,
+              static_cast<long long>(getPercentile(result.latencies, 50)),
+              static_cast<long long>(getPercentile(result.latencies, 99)),
+              mbps,
+              static_cast<long long>(result.errors));
+}
+
+std::vector<Target> getTargets() {
+  oatpp::swagger::ControllerPaths paths;
+  std::string uiResources = paths.uiResources;
+  auto resourcesPrefix = "/" + uiResources.substr(0, uiResources.find("{filename}"));
+  return {
+    {"api", "/" + paths.apiJson},
+    {"getUIRoot", "/" + paths.ui},
+    {"getInitializer", "/" + paths.initializer},
+    {"getUIResource (small)", resourcesPrefix + "index.css"},
+    {"getUIResource (1.4 MB)", resourcesPrefix + "swagger-ui-bundle.js"}
+  };
+}
+
+/*
+ * Start server with the given connection handler, run all targets, stop server.
+ */
+void runServer(const Options& options, const std::shared_ptr<oatpp::network::ConnectionHandler>& handler, const char* label) {
+
+  auto serverProvider = oatpp::network::tcp::server::ConnectionProvider::createShared(
+    {"127.0.0.1", options.port, oatpp::network::Address::IP_4}
+  );
+
+  oatpp::network::Server server(serverProvider, handler);
+  std::thread serverThread([&server] {
+    server.run();
+  });
+
+  std::printf("\n[%s] concurrency=%d, requests=%d\n", label, options.concurrency, options.requests);
+
+  for(auto& target : getTargets()) {
+    printResult(target, runTarget(options, target));
+  }
+
+  server.stop();
+  handler->stop();
+  serverProvider->stop();
+  serverThread.join();
+
+}
+
+void runController(const Options& options, const std::shared_ptr<oatpp::swagger::Resources>& resources, const char* label) {
+
+  auto objectMapper = std::make_shared<oatpp::json::ObjectMapper>();
+  auto controller = TestController::createShared(objectMapper);
+
+  oatpp::web::server::api::Endpoints docEndpoints;
+  docEndpoints.append(controller->getEndpoints());
+
+  OATPP_COMPONENT(std::shared_ptr<oatpp::swagger::DocumentInfo>, documentInfo);
+  auto swaggerController = oatpp::swagger::Controller::createShared(docEndpoints, documentInfo, resources);
+
+  auto router = oatpp::web::server::HttpRouter::createShared();
+  router->addController(swaggerController);
+
+  auto handler = oatpp::web::server::HttpConnectionHandler::createShared(router);
+  runServer(options, handler, label);
+
+}
+
+void runAsyncController(const Options& options, const std::shared_ptr<oatpp::swagger::Resources>& resources, const char* label) {
+
+  auto objectMapper = std::make_shared<oatpp::json::ObjectMapper>();
+  auto controller = TestController::createShared(objectMapper);
+
+  oatpp::web::server::api::Endpoints docEndpoints;
+  docEndpoints.append(controller->getEndpoints());
+
+  OATPP_COMPONENT(std::shared_ptr<oatpp::swagger::DocumentInfo>, documentInfo);
+  auto swaggerController = oatpp::swagger::AsyncController::createShared(docEndpoints, documentInfo, resources);
+
+  auto router = oatpp::web::server::HttpRouter::createShared();
+  router->addController(swaggerController);
+
+  auto executor = std::make_shared<oatpp::async::Executor>(options.threads, 1, 1);
+  auto handler = oatpp::web::server::AsyncHttpConnectionHandler::createShared(router, executor);
+  runServer(options, handler, label);
+
+  executor->waitTasksFinished();
+  executor->stop();
+  executor->join();
+
+}
+
+Options parseOptions(int argc, const char* argv[]) {
+
+  Options options;
+
+  for(int i = 1; i + 1 < argc; i += 2) {
+    const char* key = argv[i];
+    v_int32 value = std::atoi(argv[i + 1]);
+    if(std::strcmp(key, "--concurrency") == 0) options.concurrency = value;
+    else if(std::strcmp(key, "--requests") == 0) options.requests = value;
+    else if(std::strcmp(key, "--threads") == 0) options.threads = value;
+    else if(std::strcmp(key, "--port") == 0) options.port = static_cast<v_uint16>(value);
+    else {
+      std::cerr << "Unknown option '" << key << "'\n";
+    }
+  }
+
+  if(options.concurrency < 1) options.concurrency = 1;
+  if(options.requests < 1) options.requests = 1;
+  if(options.threads < 1) options.threads = 1;
+
+  return options;
+
+}
+
+}}}}
+
+int main(int argc, const char* argv[]) {
+
+  oatpp::Environment::init();
+
+  {
+    using namespace oatpp::test::swagger::benchmark;
+
+    auto options = parseOptions(argc, argv);
+
+    SwaggerComponents components;
+
+    auto inMemory = std::make_shared<oatpp::swagger::Resources>(OATPP_SWAGGER_RES_PATH, false);
+    auto streaming = std::make_shared<oatpp::swagger::Resources>(OATPP_SWAGGER_RES_PATH, true);
+
+    runController(options, inMemory, "Controller, in-memory resources");
+    runController(options, streaming, "Controller, streaming resources");
+    runAsyncController(options, inMemory, "AsyncController, in-memory resources");
+    runAsyncController(options, streaming, "AsyncController, streaming resources");
+
+  }
+
+  oatpp::Environment::destroy();
+
+  return 0;
+
+}
@@ -119,7 +119,7 @@ private:
 
 public:
 
-  static const oatpp::ClassId CLASS_ID;
+  static inline const oatpp::ClassId CLASS_ID{"test::Point"};
 
   static oatpp::Type *getType() {
     static oatpp::Type* type = createType();
@@ -128,8 +128,6 @@ public:
 
 };
 
-const oatpp::ClassId PointClass::CLASS_ID("test::Point");
-
 }
 
 #include OATPP_CODEGEN_END(DTO)
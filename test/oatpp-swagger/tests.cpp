@@ -2,11 +2,29 @@
 
 #include "./AsyncControllerTest.hpp"
 #include "./ControllerTest.hpp"
+#include "./DocumentEventsTest.hpp"
+#include "./GeneratorTest.hpp"
+#include "./JsonPatchTest.hpp"
+#include "./UiRendererTest.hpp"
+#include "./TagDocumentsTest.hpp"
+#include "./SearchIndexTest.hpp"
+#include "./DocumentFragmentsTest.hpp"
+#include "./SizeAnalyzerTest.hpp"
+#include "./MetricsTest.hpp"
 #include <iostream>
 
 void runTests() {
   OATPP_RUN_TEST(oatpp::test::swagger::ControllerTest);
   OATPP_RUN_TEST(oatpp::test::swagger::AsyncControllerTest);
+  OATPP_RUN_TEST(oatpp::test::swagger::GeneratorTest);
+  OATPP_RUN_TEST(oatpp::test::swagger::JsonPatchTest);
+  OATPP_RUN_TEST(oatpp::test::swagger::DocumentEventsTest);
+  OATPP_RUN_TEST(oatpp::test::swagger::UiRendererTest);
+  OATPP_RUN_TEST(oatpp::test::swagger::TagDocumentsTest);
+  OATPP_RUN_TEST(oatpp::test::swagger::SearchIndexTest);
+  OATPP_RUN_TEST(oatpp::test::swagger::DocumentFragmentsTest);
+  OATPP_RUN_TEST(oatpp::test::swagger::SizeAnalyzerTest);
+  OATPP_RUN_TEST(oatpp::test::swagger::MetricsTest);
 }
 
 int main() {